@@ -1,40 +1,81 @@
 TEMPLATE = app
-CONFIG += console c++17
+CONFIG += console c++17 thread
 CONFIG -= app_bundle
 CONFIG -= qt
 
 QMAKE_MACOSX_DEPLOYMENT_TARGET = 10.16
 
+# Uncomment to export VTKHDF files (see exporting/VTKHDFFile.h), needs libhdf5.
+# DEFINES += EXPORTING_WITH_HDF5
+# LIBS += -lhdf5
+
 SOURCES += \
     WorkingWithCSVFile.cpp \
     exporting/CSVFile.cpp \
+    exporting/PVDFile.cpp \
+    exporting/PVTUFile.cpp \
     exporting/TextFile.cpp \
+    exporting/VTKAttributeFile.cpp \
     exporting/VTKFile.cpp \
+    exporting/VTKHDFFile.cpp \
+    exporting/VTKRectilinearGridFile.cpp \
+    exporting/VTKStructuredFile.cpp \
+    exporting/VTKStructuredGridFile.cpp \
+    exporting/VTKStructuredPointsFile.cpp \
+    exporting/VTKWriterThread.cpp \
+    exporting/VTUFile.cpp \
+    exporting/XDMFFile.cpp \
     exporting/file_system/BaseFile.cpp \
+    exporting/file_system/FileRegistar.cpp \
+    exporting/file_system/IOQueue.cpp \
     exporting/file_system/SingleFile.cpp \
+    exporting/file_system/WorkerPool.cpp \
     exporting/vtk/VTKAttributeSection.cpp \
     exporting/vtk/VTKCell.cpp \
     exporting/vtk/VTKCellSection.cpp \
     exporting/vtk/VTKCellTypeSection.cpp \
+    exporting/vtk/VTKPointWelder.cpp \
     exporting/vtk/VTKSection.cpp \
-    exporting/vtk/VTKPointSection.cpp
+    exporting/vtk/VTKPointSection.cpp \
+    exporting/vtk/VTKShard.cpp
 
 HEADERS += \
+    exporting/ByteOrder.h \
     exporting/CSV.h \
     exporting/CSVFile.h \
     exporting/CSVFileSeries.h \
+    exporting/NumberFormat.h \
+    exporting/PVDFile.h \
+    exporting/PVTUFile.h \
+    exporting/Span.h \
     exporting/TextFile.h \
     exporting/TextFileSeries.h \
     exporting/VTK.h \
+    exporting/VTKAttributeFile.h \
     exporting/VTKFile.h \
     exporting/VTKFileSeries.h \
+    exporting/VTKHDFFile.h \
+    exporting/VTKRectilinearGridFile.h \
+    exporting/VTKStructuredFile.h \
+    exporting/VTKStructuredGridFile.h \
+    exporting/VTKStructuredPointsFile.h \
+    exporting/VTKWriterThread.h \
+    exporting/VTUFile.h \
+    exporting/XDMFFile.h \
     exporting/file_system/BaseFile.h \
+    exporting/file_system/FileRegistar.h \
     exporting/file_system/FileSeries.h \
     exporting/file_system/FileSeriesImp.h \
+    exporting/file_system/IOQueue.h \
+    exporting/file_system/RingBuffer.h \
     exporting/file_system/SingleFile.h \
+    exporting/file_system/WorkerPool.h \
     exporting/vtk/VTKAttributeSection.h \
     exporting/vtk/VTKCell.h \
     exporting/vtk/VTKCellSection.h \
     exporting/vtk/VTKCellTypeSection.h \
+    exporting/vtk/VTKPointTraits.h \
+    exporting/vtk/VTKPointWelder.h \
     exporting/vtk/VTKSection.h \
-    exporting/vtk/VTKPointSection.h
+    exporting/vtk/VTKPointSection.h \
+    exporting/vtk/VTKShard.h
@@ -23,7 +23,7 @@ double random(double dmin, double dmax)
     return dmin + d * (dmax - dmin);
 }
 
-using Point = VTKFile::Point;
+using Point = VTKFile::Point3;
 Point randomPoint(double boxDim){
     return {
         random(-boxDim, boxDim),
@@ -71,7 +71,7 @@ int main() {
          << " points, in a box centerd at the center of global coordinate system and dimension of "
          << to_string(simulationBoxDimention) << "m." << endl;
     std::srand(std::time(nullptr)); // Use current time as seed for random generator
-    vector<VTKFile::Point> points;
+    vector<Point> points;
     points.reserve(numberOfPoints);
     for(int pNum = 0; pNum < numberOfPoints; pNum++) {
         points.push_back(randomPoint(simulationBoxDimention));
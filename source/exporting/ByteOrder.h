@@ -0,0 +1,120 @@
+//
+//  ByteOrder.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef BYTEORDER_H
+#define BYTEORDER_H
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * The exporting namespace provides the means to handle exporting simulation data to files.
+ */
+namespace exporting {
+
+/**
+ * @brief The ByteOrder class provides the means to convert numbers between the little and big endian byte orders.
+ * @note The class is not default constructable.
+ */
+class ByteOrder
+{
+public:
+
+    using Size = std::size_t;
+
+    /**
+     * @brief The order of the bytes of a number in the memory or on a file.
+     */
+    enum class Endian {
+        Little,     // The least significant byte comes first (e.g., x86 and arm machines).
+        Big         // The most significant byte comes first (e.g., the legacy binary vtk files).
+    };
+
+    explicit ByteOrder() = delete;
+
+    /**
+     * @brief Gives the byte order of the machine.
+     */
+    static constexpr Endian native() {
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        return Endian::Big;
+#else
+        return Endian::Little;
+#endif
+    }
+
+    /**
+     * @brief Reverses the order of the bytes of a number.
+     * @tparam T The number type, (1, 2, 4 or 8 bytes long).
+     * @param value The number.
+     * @return The number with reversed bytes.
+     */
+    template<typename T>
+    static T swap(const T value) {
+        static_assert(std::is_arithmetic_v<T>, "Only the numbers can be swapped.");
+        using Bits = std::conditional_t<sizeof(T) == 1, std::uint8_t,
+                     std::conditional_t<sizeof(T) == 2, std::uint16_t,
+                     std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t> > >;
+        static_assert(sizeof(Bits) == sizeof(T), "The number size is not supported.");
+
+        Bits bits;
+        std::memcpy(&bits, &value, sizeof(T));
+        bits = swapBits(bits);
+        T ans;
+        std::memcpy(&ans, &bits, sizeof(T));
+        return ans;
+    }
+
+    /**
+     * @brief Converts a number from the machine byte order to the given byte order.
+     * @param value The number.
+     * @param endian The target byte order.
+     */
+    template<typename T>
+    static T to(const T value, const Endian endian) {
+        return (endian == native()) ? value : swap(value);
+    }
+
+    /**
+     * @brief Reverses the order of the bytes of all the numbers in an array.
+     * @note The loop is kept branch free, so that it can be vectorized by the compiler.
+     * @param values The begining of the array.
+     * @param count The number of values.
+     */
+    template<typename T>
+    static void swap(T * values, const Size count) {
+        for (Size i = 0; i < count; i++)
+            values[i] = swap(values[i]);
+    }
+
+private:
+
+    static constexpr std::uint8_t swapBits(const std::uint8_t bits) {
+        return bits;
+    }
+
+    static constexpr std::uint16_t swapBits(const std::uint16_t bits) {
+        return static_cast<std::uint16_t>((bits << 8) | (bits >> 8));
+    }
+
+    static constexpr std::uint32_t swapBits(const std::uint32_t bits) {
+        return ((bits & 0x000000FFu) << 24) | ((bits & 0x0000FF00u) << 8)
+                | ((bits & 0x00FF0000u) >> 8) | ((bits & 0xFF000000u) >> 24);
+    }
+
+    static constexpr std::uint64_t swapBits(const std::uint64_t bits) {
+        return (static_cast<std::uint64_t>(swapBits(static_cast<std::uint32_t>(bits))) << 32)
+                | swapBits(static_cast<std::uint32_t>(bits >> 32));
+    }
+
+};
+
+} // namespace exporting
+
+#endif // BYTEORDER_H
@@ -7,13 +7,23 @@
 //
 
 #include "CSVFile.h"
+#include <algorithm>
+#include <memory>
 #include <vector>
 
 namespace exporting {
 
+namespace {
+
+thread_local std::unique_ptr<char[]> textBufferOfThread;   // The text buffer of the parallel appends.
+thread_local std::size_t textBufferCapacity = 0;            // The number of chars of the text buffer.
+
+} // namespace
+
 CSVFile::CSVFile(const std::string &name,
                  const std::string &extension)
     : TextFile(name, extension)
+    , p_binary{false}
     , p_cellCount{0}
     , p_columnCount{0}
     , p_maxColumns{0}
@@ -27,6 +37,7 @@ CSVFile::CSVFile(const std::string &path,
                  const std::string &name,
                  const std::string &extension)
     : TextFile(path, name, extension)
+    , p_binary{false}
     , p_cellCount{0}
     , p_columnCount{0}
     , p_maxColumns{0}
@@ -66,6 +77,11 @@ const CSVFile::Seperator & CSVFile::seperator() const
     return p_seperator;
 }
 
+bool CSVFile::isBinary() const
+{
+    return p_binary;
+}
+
 bool CSVFile::appendCell(const char *c_str)
 {
     return appendCell(std::string(c_str));
@@ -91,7 +107,8 @@ bool CSVFile::nextRow()
 {
     try {
         if (p_maxRow == 0 || p_rowCount < p_maxRow) {
-            TextFile::nextLine();
+            if (!p_binary)
+                TextFile::nextLine();
             p_rowCount++;
             return true;
         }
@@ -121,6 +138,13 @@ bool CSVFile::remove()
     return false;
 }
 
+void CSVFile::setBinary(const bool binary) {
+    if(!p_cellCount)
+        p_binary = binary;
+    else
+        throw std::logic_error("The csv file cannot be changed to/from binary in the middle of the file.");
+}
+
 void CSVFile::setSeperator(const CSVFile::Seperator seperator) {
     if(!p_cellCount)
         p_seperator = seperator;
@@ -128,6 +152,32 @@ void CSVFile::setSeperator(const CSVFile::Seperator seperator) {
         throw std::logic_error("The csv file cannot be changed in the middle of the file.");
 }
 
+void CSVFile::advance(const CSVFile::Cell cells) {
+    p_cellCount += cells;
+    if (p_maxColumns == 0) {
+        p_columnCount += cells;
+    } else {
+        const auto columns = p_columnCount + cells;
+        p_rowCount += columns / p_maxColumns;
+        p_columnCount = columns % p_maxColumns;
+    }
+}
+
+char * CSVFile::textBuffer(const std::size_t size) {
+    if (textBufferCapacity < size) {
+        textBufferOfThread.reset(new char[size]);
+        textBufferCapacity = size;
+    }
+    return textBufferOfThread.get();
+}
+
+void CSVFile::releaseTextBuffer() {
+    if (textBufferCapacity > retainedText) {
+        textBufferOfThread.reset();
+        textBufferCapacity = 0;
+    }
+}
+
 void CSVFile::eraseAllSubStr(std::string &mainStr, const std::string &toErase)
 {
     size_t pos = std::string::npos;
@@ -137,7 +187,7 @@ void CSVFile::eraseAllSubStr(std::string &mainStr, const std::string &toErase)
 
 void CSVFile::filterCellContnet(std::string &string) const {
     string.erase(std::remove_if(string.begin(), string.end(), [](char c){
-        return c == '\n' || c == '\r' || c == '\t'|| c == '\f'|| c == '\v';}));
+        return c == '\n' || c == '\r' || c == '\t'|| c == '\f'|| c == '\v';}), string.end());
     eraseAllSubStr(string, p_seperator);
 }
 
@@ -155,6 +205,10 @@ bool CSVFile::directAppendToCell(const char * cellContent) noexcept
 }
 
 void CSVFile::handelRowEnding() {
+    if (p_binary) {
+        advance(1);
+        return;
+    }
     p_cellCount++;
     p_columnCount++;
     if(p_maxColumns == 0 || p_columnCount < p_maxColumns){
@@ -9,7 +9,10 @@
 #ifndef CSVFILE_H
 #define CSVFILE_H
 
+#include "Span.h"
 #include "TextFile.h"
+#include "file_system/WorkerPool.h"
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 
@@ -32,6 +35,9 @@ public:
     using Row = unsigned long;
     using Seperator = std::string;
 
+    static constexpr Cell parallelChunk = 1 << 14; // The number of cells formatted by each part of a parallel append.
+    static constexpr std::size_t retainedText = 1 << 20; // The chars of the parallel appends' buffer kept per thread.
+
     /**
      * @brief The constructor.
      * @param name The name of the file (the path to the file included).
@@ -89,6 +95,11 @@ public:
      */
     const Seperator& seperator() const;
 
+    /**
+     * @brief Whether the cells are stored as raw bytes, without seperators and line endings, or not.
+     */
+    bool isBinary() const;
+
     /**
      * @brief Appends a cell to the file.
      * @note If maxColumn is set this will call the next row at the end of each row.
@@ -117,9 +128,22 @@ public:
      */
     template<typename N>
     bool appendCell(const N number, bool scientific) {
+        return appendCell(number, NumberFormat::of<N>(scientific));
+    }
+
+    /**
+     * @brief Appends a cell to the file.
+     * @note If maxColumn is set this will call the next row at the end of each row.
+     * @tparam N The type of the cell content.
+     * @param number The cell content to append to the file.
+     * @param format The notation and precision of the content.
+     * @return True if it is able to append, false otherwise
+     */
+    template<typename N>
+    bool appendCell(const N number, const NumberFormat & format) {
         try {
             if (p_maxRow == 0 || p_rowCount < p_maxRow) {
-                TextFile::appendNumber(number, scientific, -1);
+                TextFile::appendNumber(number, format);
                 handelRowEnding();
                 return true;
             }
@@ -138,12 +162,87 @@ public:
      */
     template<typename ITRT>
     unsigned long appendRow(const ITRT & rowContents, const bool scientific = true) {
+        using N = std::decay_t<decltype(*std::begin(rowContents))>;
+        return appendRow(rowContents, NumberFormat::of<N>(scientific));
+    }
+
+    /**
+     * @brief Appends a row to the file.
+     * @note If maxColumn is set this will call the next row at the end of each row.
+     * @tparam ITRT The type of the row content which should be itratable.
+     * @param rowContents The row to append to the file.
+     * @param format The notation and precision of the contents.
+     * @return The number of successfuly added cells.
+     */
+    template<typename ITRT>
+    unsigned long appendRow(const ITRT & rowContents, const NumberFormat & format) {
+        if constexpr (isContiguous<ITRT>::value) {
+            if (p_binary && format.isBinary())
+                return appendBinaryCells(std::data(rowContents), std::size(rowContents), format);
+        }
         unsigned long successfull = 0;
-        for (const auto content : rowContents)
-            successfull += appendCell(content, scientific);
+        for (const auto & content : rowContents)
+            successfull += appendCell(content, format);
         return successfull;
     }
 
+    /**
+     * @brief Appends an array of numbers to the file in one pass.
+     * @details The result is the same as appending the numbers one by one (see appendCell) and calling nextRow
+     *          after every rowSize numbers, but the numbers are formatted block by block and the file is
+     *          written once per block.
+     * @note If maxColumn is set this will call the next row at the end of each row.
+     * @note The maxRow is only checked once, before appending the first number.
+     * @tparam N The type of the cells contents.
+     * @param numbers The begining of the array.
+     * @param count The number of the numbers.
+     * @param rowSize The number of cells between each nextRow call, zero to not call nextRow.
+     * @param format The notation and precision of the contents.
+     * @return The number of successfuly added cells.
+     * @throws If the count is not a multiple of the rowSize.
+     */
+    template<typename N>
+    unsigned long appendCells(const N * numbers, const Cell count, const Column rowSize, const NumberFormat & format) {
+        if (rowSize && count % rowSize)
+            throw std::range_error("The number of the cells should be a multiple of the row size.");
+        return appendCells(numbers, count, (rowSize) ? count / rowSize : 0, format, [rowSize](const Cell cell) {
+            return rowSize && (cell + 1) % rowSize == 0;
+        }, true);
+    }
+
+    /**
+     * @brief Appends an array of numbers, as rows of different sizes, to the file in one pass.
+     * @details The result is the same as appending the numbers one by one (see appendCell) and calling nextRow
+     *          at the end of each row, but the numbers are formatted block by block and the file is
+     *          written once per block.
+     * @note If maxColumn is set this will call the next row at the end of each row.
+     * @note The maxRow is only checked once, before appending the first number.
+     * @tparam N The type of the cells contents.
+     * @param numbers The begining of the array, row after row.
+     * @param rowSizes The number of cells of each row.
+     * @param format The notation and precision of the contents.
+     * @return The number of successfuly added cells.
+     * @throws If any of the rows is empty.
+     */
+    template<typename N>
+    unsigned long appendCells(const N * numbers, Span<const Column> rowSizes, const NumberFormat & format) {
+        Cell count = 0;
+        for (const auto size : rowSizes) {
+            if (!size)
+                throw std::range_error("The rows should not be empty.");
+            count += size;
+        }
+        auto row = rowSizes.begin();
+        Cell rowEnd = (row != rowSizes.end()) ? *row : 0;
+        return appendCells(numbers, count, rowSizes.size(), format, [&](const Cell cell) {
+            if (cell + 1 != rowEnd)
+                return false;
+            if (++row != rowSizes.end())
+                rowEnd += *row;
+            return true;
+        });
+    }
+
     /**
      * @brief Gives direct accessthe to the maximum column number posible in the table.
      * @return The maximum column number posible in the table, zero if no limit.
@@ -176,6 +275,15 @@ public:
      */
     bool remove();
 
+    /**
+     * @brief Sets whether the cells are stored as raw bytes or not.
+     * @note In the binary mode the table (i.e., cell, column, and row counts) is kept but no seperator or line ending is written.
+     * @note Use this immediately after the constructor.
+     * @param binary If true, the seperators and line endings will not be written.
+     * @throws If the file is not empty.
+     */
+    void setBinary(const bool binary);
+
     /**
      * @brief Sets the seperator of the csv file.
      * @note Use this immediately after the constructor.
@@ -187,6 +295,168 @@ public:
 
 protected:
 
+    /**
+     * @brief Whether the ITRT type stores its elements contiguously or not.
+     */
+    template<typename ITRT, typename = void>
+    struct isContiguous: std::false_type {};
+
+    template<typename ITRT>
+    struct isContiguous<ITRT, std::void_t<decltype(std::data(std::declval<const ITRT &>())),
+                                          decltype(std::size(std::declval<const ITRT &>()))> >: std::true_type {};
+
+    /**
+     * @brief Appends an array of numbers as raw bytes and updates the table accordingly.
+     * @tparam N The number type.
+     * @param numbers The begining of the array.
+     * @param count The number of the numbers.
+     * @param format The binary format of the numbers.
+     * @return The number of successfuly added cells.
+     */
+    template<typename N>
+    unsigned long appendBinaryCells(const N * numbers, const Cell count, const NumberFormat & format) {
+        try {
+            if (p_maxRow == 0 || p_rowCount < p_maxRow) {
+                TextFile::appendBinary(numbers, count, format);
+                advance(count);
+                return count;
+            }
+        } catch (...) {
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Appends an array of numbers to the file in one pass (see the public appendCells).
+     * @note The large arrays are split into chunks formatted on the WorkerPool, if the row ending functor allows it.
+     * @tparam N The type of the cells contents.
+     * @tparam ROW_END The functor that tells whether a cell (i.e., its index in the array) is the end of a row.
+     * @param numbers The begining of the array.
+     * @param count The number of the numbers.
+     * @param rows The number of the rows (i.e., the nextRow calls) inside the array.
+     * @param format The notation and precision of the contents.
+     * @param isRowEnd The row ending functor, called once per cell in order.
+     * @param parallel Whether the row ending functor can be called for any cell from any thread (i.e., it is stateless) or not.
+     * @return The number of successfuly added cells.
+     */
+    template<typename N, typename ROW_END>
+    unsigned long appendCells(const N * numbers, const Cell count, const Row rows,
+                              const NumberFormat & format, ROW_END isRowEnd, const bool parallel = false) {
+        if (!count || (p_maxRow != 0 && p_rowCount >= p_maxRow))
+            return 0;
+
+        if (p_binary && format.isBinary()) {
+            const auto ans = appendBinaryCells(numbers, count, format);
+            if (ans == count)
+                p_rowCount += rows;
+            return ans;
+        }
+
+        unsigned long successfull = 0;
+        try {
+            const auto column = p_columnCount;
+            const auto cellLength = format.maxWidth<N>() + p_seperator.size() + 2;
+            auto & pool = file_system::WorkerPool::current();
+            if (parallel && count >= 2 * parallelChunk && pool.threadCount() > 1) {
+                // The chunks are formatted a few at a time on the pool, then written in order.
+                const auto chunks = (count + parallelChunk - 1) / parallelChunk;
+                const Cell wave = std::min<Cell>(2 * pool.threadCount(), chunks);
+                // Only a wave of chunks is held at once, the last one may be shorter than the others.
+                const auto texts = textBuffer(std::min(count, wave * parallelChunk) * cellLength);
+                std::vector<char *> ends(wave);
+                std::vector<Row> rowsOf(wave);
+                for (Cell first = 0; first < chunks; first += wave) {
+                    const auto size = std::min(wave, chunks - first);
+                    pool.run(size, [&](const std::size_t chunk) {
+                        const auto begin = (first + chunk) * parallelChunk;
+                        rowsOf[chunk] = 0;
+                        ends[chunk] = formatCells(texts + chunk * parallelChunk * cellLength, numbers, begin,
+                                                  std::min(count, begin + parallelChunk), column, format, isRowEnd, rowsOf[chunk]);
+                    });
+                    for (Cell chunk = 0; chunk < size; chunk++) {
+                        const auto begin = (first + chunk) * parallelChunk;
+                        const auto cells = std::min(count, begin + parallelChunk) - begin;
+                        const auto text = texts + chunk * parallelChunk * cellLength;
+                        write(text, ends[chunk] - text);
+                        advance(cells);
+                        p_rowCount += rowsOf[chunk];
+                        successfull += cells;
+                    }
+                }
+                releaseTextBuffer();
+            } else {
+                constexpr std::size_t blockSize = 1 << 16;
+                char block[blockSize];
+                const auto perBlock = blockSize / cellLength;
+                for (Cell begin = 0; begin < count; begin += perBlock) {
+                    const auto end = std::min(count, begin + perBlock);
+                    Row blockRows = 0;
+                    write(block, formatCells(block, numbers, begin, end, column, format, isRowEnd, blockRows) - block);
+                    advance(end - begin);
+                    p_rowCount += blockRows;
+                    successfull += end - begin;
+                }
+            }
+        } catch (...) {
+            releaseTextBuffer();
+        }
+        return successfull;
+    }
+
+    /**
+     * @brief Formats a part of an array of numbers exactly as appendCells writes it, without changing the table.
+     * @note Each number takes at most the format's maxWidth plus the seperator and two new lines chars.
+     * @tparam N The type of the cells contents.
+     * @tparam ROW_END The row ending functor (see appendCells).
+     * @param out The begining of the text.
+     * @param numbers The begining of the array.
+     * @param begin The index of the first number of the part.
+     * @param end The index after the last number of the part.
+     * @param column The column count before the first number of the array.
+     * @param format The notation and precision of the contents.
+     * @param isRowEnd The row ending functor.
+     * @param rows Is increased by the number of the row ends of the part (i.e., not the max column ones).
+     * @return The end of the text.
+     */
+    template<typename N, typename ROW_END>
+    char * formatCells(char * out, const N * numbers, const Cell begin, const Cell end, const Column column,
+                       const NumberFormat & format, ROW_END & isRowEnd, Row & rows) const {
+        for (auto i = begin; i < end; i++) {
+            out = format.write(out, out + format.maxWidth<N>(), numbers[i]);
+            if (!p_binary) {
+                if(p_maxColumns == 0 || (column + i + 1) % p_maxColumns) {
+                    out = std::copy(p_seperator.begin(), p_seperator.end(), out);
+                } else {
+                    *out++ = '\n'; // The row is counted by advance.
+                }
+            }
+            if (isRowEnd(i)) {
+                if (!p_binary)
+                    *out++ = '\n';
+                rows++;
+            }
+        }
+        return out;
+    }
+
+    /**
+     * @brief Advances the cell, column, and row counts as if the cells are appended without writing anything.
+     * @param cells The number of appended cells.
+     */
+    void advance(const Cell cells);
+
+    /**
+     * @brief Gives the text buffer of the parallel appends of the calling thread, reused across the calls.
+     * @note The buffer is not initialized; its content is lost on the next call.
+     * @param size The minimum number of chars of the buffer.
+     */
+    static char * textBuffer(const std::size_t size);
+
+    /**
+     * @brief Releases the text buffer of the calling thread if it holds more than retainedText chars.
+     */
+    static void releaseTextBuffer();
+
     /**
      * @brief Erases all Occurrences of given substring from main string.
      */
@@ -216,6 +486,7 @@ protected:
 
 private:
 
+    bool p_binary;
     Cell p_cellCount;
     Column p_columnCount;
     Column p_maxColumns;
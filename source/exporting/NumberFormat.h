@@ -0,0 +1,255 @@
+//
+//  NumberFormat.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef NUMBERFORMAT_H
+#define NUMBERFORMAT_H
+
+#include "ByteOrder.h"
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/**
+ * The exporting namespace provides the means to handle exporting simulation data to files.
+ */
+namespace exporting {
+
+/**
+ * @brief The NumberFormat class provides the means to convert numbers to text without the printf machinery.
+ * @details The notation and the precision are resolved once (e.g., per section) and the numbers are
+ *          written with std::to_chars, which gives the same characters as the equivalent printf format.
+ *          The binary formats write the raw bytes of the number in a given storage type and byte order instead.
+ */
+class NumberFormat
+{
+public:
+
+    using CharCount = int;
+    using Endian = ByteOrder::Endian;
+    using Precision = int;
+    using Size = std::size_t;
+
+    /**
+     * @brief The notation of the numbers.
+     */
+    enum class Notation {
+        Fixed,          // Same as the "%.<precision>f" printf format.
+        Scientific,     // Same as the "%.<precision>e" printf format.
+        Binary          // The raw bytes of the number.
+    };
+
+    /**
+     * @brief The type that the numbers are stored as, in the binary notation.
+     */
+    enum class Storage {
+        UInt8,
+        Int32,
+        Int64,
+        UInt64,
+        Float32,
+        Float64
+    };
+
+    static constexpr CharCount maxLength = 384;     // The maximum number of chars a single number can take.
+    static constexpr Precision maxPrecision = 48;   // The precisions above this will be cut off.
+
+    /**
+     * @brief The constructor.
+     * @param notation The notation of the numbers.
+     * @param precision The number of char after dot(.) to print.
+     */
+    explicit constexpr NumberFormat(const Notation notation = Notation::Fixed, const Precision precision = 0)
+        : p_endian{ByteOrder::native()}
+        , p_notation{notation}
+        , p_precision{(precision < 0) ? 0 : ((precision > maxPrecision) ? maxPrecision : precision)}
+        , p_storage{Storage::Float64}
+    {
+    }
+
+    /**
+     * @brief Gives a binary format.
+     * @param storage The type that the numbers are stored as.
+     * @param endian The byte order of the stored numbers.
+     */
+    static constexpr NumberFormat binary(const Storage storage, const Endian endian = Endian::Big) {
+        auto ans = NumberFormat(Notation::Binary, 0);
+        ans.p_endian = endian;
+        ans.p_storage = storage;
+        return ans;
+    }
+
+    /**
+     * @brief Gives the number of bytes of a storage type.
+     * @param storage The storage type.
+     */
+    static constexpr Size sizeOf(const Storage storage) {
+        switch (storage) {
+        case Storage::UInt8:    return 1;
+        case Storage::Int32:
+        case Storage::Float32:  return 4;
+        case Storage::Int64:
+        case Storage::UInt64:
+        case Storage::Float64:  return 8;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Gives the default format of a number type.
+     * @tparam N The number type.
+     * @param scientific Whether print the number with schientific notation or not.
+     * @param precision The number of char after dot(.) to print, negative for the default of the number type.
+     * @return The format for the number type.
+     */
+    template<typename N>
+    static constexpr NumberFormat of(const bool scientific, const Precision precision = -1) {
+        const Precision defaultPrecision = std::is_same_v<N, double> ? 12 : (std::is_same_v<N, float> ? 6 : 0);
+        return NumberFormat((scientific) ? Notation::Scientific : Notation::Fixed,
+                            (precision < 0) ? defaultPrecision : precision);
+    }
+
+    /**
+     * @brief Gives the byte order of the binary format.
+     */
+    constexpr Endian endian() const { return p_endian; }
+
+    /**
+     * @brief Whether the format writes raw bytes or not.
+     */
+    constexpr bool isBinary() const { return p_notation == Notation::Binary; }
+
+    /**
+     * @brief Gives the notation of the format.
+     */
+    constexpr Notation notation() const { return p_notation; }
+
+    /**
+     * @brief Gives the maximum number of chars (bytes, for the binary formats) a number of a type takes in the format.
+     * @note The sign, the dot, and the exponent are included, but never more than maxLength.
+     * @tparam N The number type.
+     */
+    template<typename N>
+    constexpr CharCount maxWidth() const {
+        if (isBinary())
+            return static_cast<CharCount>(sizeOf(p_storage));
+        CharCount digits = 1; // The integer digits of the largest number (i.e., the bool).
+        if constexpr (std::is_floating_point_v<N>)
+            digits += (std::numeric_limits<N>::max_exponent10 < std::numeric_limits<double>::max_exponent10)
+                    ? std::numeric_limits<N>::max_exponent10 : std::numeric_limits<double>::max_exponent10;
+        else if constexpr (std::is_integral_v<N> && !std::is_same_v<N, bool>)
+            digits += std::numeric_limits<N>::digits10;
+        const auto width = (p_notation == Notation::Scientific) ? p_precision + 8 // -d.<precision>e-ddd
+                                                                : digits + p_precision + 2; // -<digits>.<precision>
+        return (width < maxLength) ? width : maxLength;
+    }
+
+    /**
+     * @brief Gives the number of char after dot(.) of the format.
+     */
+    constexpr Precision precision() const { return p_precision; }
+
+    /**
+     * @brief Gives the storage type of the binary format.
+     */
+    constexpr Storage storage() const { return p_storage; }
+
+    /**
+     * @brief Writes a number to a char range.
+     * @note The range should be at least maxWidth<N>() long.
+     * @tparam N The number type.
+     * @param first The begining of the range.
+     * @param last The end of the range.
+     * @param number The number to write.
+     * @return The pointer to one past the last written char, or first if the number does not fit in the range.
+     */
+    template<typename N>
+    char * write(char * first, char * last, const N number) const {
+        if (isBinary())
+            return (static_cast<Size>(last - first) < sizeOf(p_storage)) ? first : write(first, &number, 1);
+        if constexpr (std::is_integral_v<N> && !std::is_same_v<N, bool>) {
+            if (p_notation == Notation::Fixed && p_precision == 0) {
+                const auto result = std::to_chars(first, last, number);
+                return (result.ec == std::errc()) ? result.ptr : first;
+            }
+        }
+        const auto value = (isZero(number)) ? 0.0 : static_cast<double>(number);
+        const auto format = (p_notation == Notation::Scientific) ? std::chars_format::scientific : std::chars_format::fixed;
+        const auto result = std::to_chars(first, last, value, format, p_precision);
+        return (result.ec == std::errc()) ? result.ptr : first;
+    }
+
+    /**
+     * @brief Writes the raw bytes of an array of numbers back to back.
+     * @note Only for the binary formats, the destination should be at least count * sizeOf(storage()) long.
+     * @tparam N The number type.
+     * @param first The begining of the destination.
+     * @param numbers The begining of the array.
+     * @param count The number of the numbers.
+     * @return The pointer to one past the last written byte.
+     */
+    template<typename N>
+    char * write(char * first, const N * numbers, const Size count) const {
+        switch (p_storage) {
+        case Storage::UInt8:    return writeBinary<std::uint8_t>(first, numbers, count);
+        case Storage::Int32:    return writeBinary<std::int32_t>(first, numbers, count);
+        case Storage::Int64:    return writeBinary<std::int64_t>(first, numbers, count);
+        case Storage::UInt64:   return writeBinary<std::uint64_t>(first, numbers, count);
+        case Storage::Float32:  return writeBinary<float>(first, numbers, count);
+        case Storage::Float64:  return writeBinary<double>(first, numbers, count);
+        }
+        return first;
+    }
+
+private:
+
+    /**
+     * @brief Writes the numbers as the given storage type with the byte order of the format.
+     * @note The conversion and the byte swap are done in separate tight loops to be vectorized.
+     */
+    template<typename S, typename N>
+    char * writeBinary(char * first, const N * numbers, const Size count) const {
+        constexpr Size blockSize = 512;
+        S block[blockSize];
+        for (Size done = 0; done < count; done += blockSize) {
+            const auto size = (count - done < blockSize) ? count - done : blockSize;
+            for (Size i = 0; i < size; i++)
+                block[i] = static_cast<S>(numbers[done + i]);
+            if (p_endian != ByteOrder::native())
+                ByteOrder::swap(block, size);
+            std::memcpy(first, block, size * sizeof(S));
+            first += size * sizeof(S);
+        }
+        return first;
+    }
+
+    /**
+     * @brief Whether the value is close enoght to zero or not.
+     * @param value The value to check.
+     * @return True, if the value is close to zero false otherwise.
+     */
+    template<typename T>
+    static constexpr bool isZero(const T value) {
+        if constexpr (std::is_same_v<T, double>)
+            return ((value >= 0) ? value : -value) <= 0.00000000001;
+        else if constexpr (std::is_same_v<T, float>)
+            return ((value >= 0) ? value : -value) <= 0.00001f;
+        else
+            return value == 0;
+    }
+
+    Endian p_endian;        // The byte order of the binary notation.
+    Notation p_notation;    // The notation of the numbers.
+    Precision p_precision;  // The number of char after dot(.) to print.
+    Storage p_storage;      // The type that the numbers are stored as, in the binary notation.
+
+};
+
+} // namespace exporting
+
+#endif // NUMBERFORMAT_H
@@ -0,0 +1,56 @@
+//
+//  PVDFile.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "PVDFile.h"
+#include <charconv>
+#include <stdexcept>
+
+namespace exporting {
+
+const std::string PVDFile::tail = "  </Collection>\n</VTKFile>\n";
+
+PVDFile::PVDFile(const std::string &name,
+                 const bool override,
+                 const std::string &extension)
+    : file_system::BaseFile{name, extension}
+    , p_count{0}
+    , p_override{override}
+{
+}
+
+PVDFile::PVDFile(const std::string &path,
+                 const std::string &name,
+                 const bool override,
+                 const std::string &extension)
+    : PVDFile{path + name, override, extension}
+{
+}
+
+PVDFile::Size PVDFile::count() const {
+    return p_count;
+}
+
+void PVDFile::appendDataSet(const double time, const std::string &file, const PVDFile::Size part) {
+    char number[64];
+    const auto timeEnd = std::to_chars(number, number + sizeof(number), time).ptr; // The shortest exact text.
+    std::string entry = "    <DataSet timestep=\"" + std::string(number, timeEnd) + "\" group=\"\" part=\""
+            + std::to_string(part) + "\" file=\"";
+    for (const auto c : file)
+        entry += (c == '"') ? std::string("&quot;") : std::string(1, c);
+    entry += "\"/>\n";
+
+    const auto startOver = !p_count && (p_override || !std::filesystem::exists(fullName(true)));
+    const auto head = "<?xml version=\"1.0\"?>\n"
+                      "<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"BigEndian\">\n"
+                      "  <Collection>\n";
+    if (!insertBeforeTail(entry, tail, head, startOver))
+        throw std::runtime_error("Could not write the collection (" + fullName(true) + "), or it does not end with the closing tags.");
+    p_count++;
+}
+
+} // namespace exporting
@@ -0,0 +1,83 @@
+//
+//  PVDFile.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef PVDFILE_H
+#define PVDFILE_H
+
+#include "file_system/BaseFile.h"
+#include <cstddef>
+
+/**
+ * The exporting namespace provides the means to handle exporting simulation data to files.
+ */
+namespace exporting {
+
+/**
+ * @brief The PVDFile class provides the means to handle a ParaView data (.pvd) collection, i.e., the list of the files of
+ *        a series along their simulation time.
+ * @details The collection is kept complete on the disk after each data set: a new data set overwrites the closing tags
+ *          (i.e., the tail) and writes them back after itself, so the previous data sets are never rewritten and the
+ *          collection can be followed while the simulation is running.
+ * @note The class is not default constructable.
+ */
+class PVDFile: public file_system::BaseFile
+{
+public:
+
+    using Size = std::size_t;
+
+    /**
+     * @brief The constructor.
+     * @param name The name of the file (the path to the file included).
+     * @param override If false, the data sets are appended to the existing collection (if any), a new collection is started otherwise.
+     * @param extension The extention of the file without the dot(.).
+     */
+    explicit PVDFile(const std::string &name,
+                     const bool override = true,
+                     const std::string &extension = "pvd");
+
+    /**
+     * @brief The constructor.
+     * @param path The directory path of the file.
+     * @param name The name of the file.
+     * @param override If false, the data sets are appended to the existing collection (if any), a new collection is started otherwise.
+     * @param extension The extention of the file without the dot(.).
+     */
+    explicit PVDFile(const std::string &path,
+                     const std::string &name,
+                     const bool override,
+                     const std::string &extension);
+
+    /**
+     * @brief Gives the number of the data sets appended by this object.
+     */
+    Size count() const;
+
+    /**
+     * @brief Appends a data set to the collection.
+     * @note Should be called once the data set file is complete (e.g., assembled), so the readers never see a partial file.
+     * @param time The simulation time of the data set.
+     * @param file The name of the data set file, relative to the directory of the collection.
+     * @param part The part of the data set (e.g., the index of a piece), for more than one file per time step.
+     * @throws If the collection could not be written.
+     * @throws If an existing collection does not end with the closing tags (when not overriding).
+     */
+    void appendDataSet(const double time, const std::string & file, const Size part = 0);
+
+private:
+
+    static const std::string tail;  // The closing tags of the collection.
+
+    Size p_count;       // The number of the data sets appended by this object.
+    bool p_override;    // Whether the collection should be started over by the first data set or not.
+
+};
+
+} // namespace exporting
+
+#endif // PVDFILE_H
@@ -0,0 +1,96 @@
+//
+//  PVTUFile.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "file_system/WorkerPool.h"
+#include "PVTUFile.h"
+
+namespace exporting {
+
+PVTUFile::PVTUFile(const std::string &name,
+                   const PVTUFile::Size pieceCount,
+                   const std::string &extension)
+    : TextFile{name, extension}
+    , p_mutex{}
+    , p_pieces(pieceCount)
+{
+    if (!pieceCount)
+        throw std::logic_error("The parallel vtu file needs at least one piece.");
+}
+
+PVTUFile::PVTUFile(const std::string &path,
+                   const std::string &name,
+                   const PVTUFile::Size pieceCount,
+                   const std::string &extension)
+    : PVTUFile{path + name, pieceCount, extension}
+{
+}
+
+PVTUFile::Size PVTUFile::pieceCount() const {
+    return p_pieces.size();
+}
+
+std::string PVTUFile::pieceName(const PVTUFile::Size index) const {
+    if (index >= pieceCount())
+        throw std::out_of_range("The piece index (" + std::to_string(index) + ") is out of range.");
+    return name(false) + "_" + std::to_string(index) + ".vtu";
+}
+
+VTUFile &PVTUFile::piece(const PVTUFile::Size index) {
+    if (index >= pieceCount())
+        throw std::out_of_range("The piece index (" + std::to_string(index) + ") is out of range.");
+    std::lock_guard<std::mutex> lock{p_mutex};
+    auto & ans = p_pieces[index];
+    if (!ans)
+        ans = std::make_unique<VTUFile>(name(true) + "_" + std::to_string(index), "vtu");
+    return *ans;
+}
+
+void PVTUFile::assemble(bool removeSections) {
+    std::vector<VTUFile *> pieces;
+    {
+        std::lock_guard<std::mutex> lock{p_mutex};
+        for (const auto & piece : p_pieces)
+            if (piece)
+                pieces.emplace_back(piece.get());
+    }
+    if (pieces.empty())
+        throw std::logic_error("No piece of the parallel vtu file is created to assemble.");
+
+    file_system::WorkerPool::current().run(pieces.size(), [&pieces, removeSections](const Size i) {
+        pieces[i]->assemble(removeSections);
+    });
+    assembleIndex();
+}
+
+void PVTUFile::assembleIndex() {
+    std::string layout;
+    for (const auto & piece : p_pieces) {
+        if (!piece)
+            continue;
+        const auto tags = piece->parallelTags();
+        if (layout.empty())
+            layout = tags;
+        else if (tags != layout)
+            throw std::runtime_error("The pieces of the parallel vtu file do not have the same attributes.");
+    }
+    if (layout.empty())
+        throw std::logic_error("No piece of the parallel vtu file is created to take the layout from.");
+
+    open(true);
+    TextFile::append("<?xml version=\"1.0\"?>\n");
+    TextFile::append("<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" byte_order=\"BigEndian\" header_type=\"UInt64\">\n");
+    TextFile::append("  <PUnstructuredGrid GhostLevel=\"0\">\n");
+    TextFile::append(layout);
+    for (Size i = 0; i < pieceCount(); i++)
+        TextFile::append("    <Piece Source=\"" + pieceName(i) + "\"/>\n");
+    TextFile::append("  </PUnstructuredGrid>\n");
+    TextFile::append("</VTKFile>\n");
+    close();
+}
+
+} // namespace exporting
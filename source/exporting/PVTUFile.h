@@ -0,0 +1,112 @@
+//
+//  PVTUFile.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef PVTUFILE_H
+#define PVTUFILE_H
+
+#include "VTUFile.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * The exporting namespace provides the means to handle exporting simulation data to files.
+ */
+namespace exporting {
+
+/**
+ * @brief The PVTUFile class provides the means to handle exporting a partitioned grid to a parallel vtk XML unstructured
+ *        grid (.pvtu) file, i.e., an index that lists one vtu file (piece) per partition.
+ * @details Each partition appends to and assembles its own piece (see piece) independently of the others, so the pieces
+ *          are written in parallel. The pieces are named after the index (i.e., <name>_<index>.vtu next to it).
+ *          - Threads: all the partitions share one PVTUFile, each thread appends to its piece and assemble writes the
+ *            pieces on the WorkerPool, then the index.
+ *          - Processes (e.g., ranks of a local mpirun): each process constructs the same PVTUFile and only touches the
+ *            piece of its rank; every process assembles its piece and the coordinator calls assemble instead, which
+ *            writes its own piece(s) and the index (the other pieces are not needed to write the index).
+ * @note The pieces should have the same attributes (i.e., names, types, and sources).
+ * @note The class is not default constructable.
+ */
+class PVTUFile: public TextFile
+{
+public:
+
+    /**
+     * @brief The constructor.
+     * @param name The name of the file (the path to the file included).
+     * @param pieceCount The number of the pieces (i.e., partitions).
+     * @param extension The extention of the file without the dot(.).
+     */
+    explicit PVTUFile(const std::string &name,
+                      const Size pieceCount,
+                      const std::string &extension = "pvtu");
+
+    /**
+     * @brief The constructor.
+     * @param path The directory path of the file.
+     * @param name The name of the file.
+     * @param pieceCount The number of the pieces (i.e., partitions).
+     * @param extension The extention of the file without the dot(.).
+     */
+    explicit PVTUFile(const std::string &path,
+                      const std::string &name,
+                      const Size pieceCount,
+                      const std::string &extension);
+
+    PVTUFile(const PVTUFile& other) = delete;
+    PVTUFile& operator =(const PVTUFile&) = delete;
+
+    /**
+     * @brief Gives the number of the pieces.
+     */
+    Size pieceCount() const;
+
+    /**
+     * @brief Gives the name of the file of a piece (without the path), as listed in the index.
+     * @param index The index of the piece.
+     * @throws If the index is not less than the piece count.
+     */
+    std::string pieceName(const Size index) const;
+
+    /**
+     * @brief Gives the vtu file of a piece.
+     * @note Creates the piece on the first call, only the created pieces are touched (e.g., assembled) by this object.
+     * @note Can be called from many threads at once, but each piece should only be appended to by one thread at a time.
+     * @param index The index of the piece.
+     * @return The vtu file of the piece.
+     * @throws If the index is not less than the piece count.
+     */
+    VTUFile & piece(const Size index);
+
+    /**
+     * @brief Assembles the created pieces in parallel, then writes the index listing all of the pieces.
+     * @note The layout of the arrays (i.e., their names, types, and components) is taken from the created pieces.
+     * @param removeSections If true, removes the temp files of the pieces' section bodies afterward.
+     * @throws If no piece is created by this object.
+     * @throws If the created pieces do not have the same attributes.
+     * @throws If any of the pieces could not be assembled (see VTUFile::assemble).
+     */
+    void assemble(bool removeSections = true);
+
+private:
+
+    /**
+     * @brief Writes the index (i.e., the arrays layout and the pieces' files).
+     * @throws If no piece is created by this object.
+     * @throws If the created pieces do not have the same attributes.
+     */
+    void assembleIndex();
+
+    std::mutex p_mutex;                             // Guards the creation of the pieces.
+    std::vector<std::unique_ptr<VTUFile> > p_pieces; // The pieces, nullptr if not created.
+
+};
+
+} // namespace exporting
+
+#endif // PVTUFILE_H
@@ -0,0 +1,236 @@
+//
+//  Span.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * The exporting namespace provides the means to handle exporting simulation data to files.
+ */
+namespace exporting {
+
+/**
+ * @brief The Span class provides a non-owning view over a contiguous array (e.g., a std::vector, a std::array, or a raw array).
+ * @note The viewed array should outlive the span.
+ * @tparam T The type of the elements (const qualified for the read only views).
+ */
+template<typename T>
+class Span
+{
+public:
+
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using Size = std::size_t;
+    using iterator = T *;
+
+    /**
+     * @brief The constructor of an empty span.
+     */
+    constexpr Span() noexcept
+        : p_data{nullptr}
+        , p_size{0}
+    {
+    }
+
+    /**
+     * @brief The constructor.
+     * @param data The begining of the array.
+     * @param size The number of the elements.
+     */
+    constexpr Span(T * data, const Size size) noexcept
+        : p_data{data}
+        , p_size{size}
+    {
+    }
+
+    /**
+     * @brief The constructor.
+     * @param array The raw array.
+     */
+    template<std::size_t N>
+    constexpr Span(T (&array)[N]) noexcept
+        : p_data{array}
+        , p_size{N}
+    {
+    }
+
+    /**
+     * @brief The constructor.
+     * @note The temporary containers can only be viewed by the read only spans (e.g., to pass them to a function).
+     * @tparam CONTAINER A contiguous container (i.e., provides std::data and std::size).
+     * @param container The container.
+     */
+    template<typename CONTAINER,
+             typename = std::enable_if_t<std::is_convertible_v<decltype(std::data(std::declval<CONTAINER>())), T *> >,
+             typename = decltype(std::size(std::declval<CONTAINER>()))>
+    constexpr Span(CONTAINER && container) noexcept
+        : p_data{std::data(container)}
+        , p_size{std::size(container)}
+    {
+    }
+
+    /**
+     * @brief Gives the begining of the array.
+     */
+    constexpr T * data() const noexcept {
+        return p_data;
+    }
+
+    /**
+     * @brief Gives the number of the elements.
+     */
+    constexpr Size size() const noexcept {
+        return p_size;
+    }
+
+    /**
+     * @brief Whether the span is empty or not.
+     */
+    constexpr bool empty() const noexcept {
+        return p_size == 0;
+    }
+
+    constexpr iterator begin() const noexcept {
+        return p_data;
+    }
+
+    constexpr iterator end() const noexcept {
+        return p_data + p_size;
+    }
+
+    /**
+     * @brief Gives the element at the index.
+     * @note The index is not checked.
+     */
+    constexpr T & operator[](const Size index) const noexcept {
+        return p_data[index];
+    }
+
+    /**
+     * @brief Gives a sub span.
+     * @param offset The index of the first element of the sub span.
+     * @param count The number of the elements of the sub span.
+     * @throws If the sub span exceeds the span.
+     */
+    Span subspan(const Size offset, const Size count) const {
+        if (offset > p_size || count > p_size - offset)
+            throw std::out_of_range("The sub span exceeds the span.");
+        return Span(p_data + offset, count);
+    }
+
+private:
+
+    T * p_data;     // The begining of the array.
+    Size p_size;    // The number of the elements.
+
+};
+
+/**
+ * @brief The StridedSpan class provides a non-owning view over the elements embedded at a fixed distance inside an array
+ *        (e.g., the position of the particles inside an array of particle structs).
+ * @note The viewed array should outlive the span.
+ * @tparam T The type of the values (const qualified for the read only views).
+ */
+template<typename T>
+class StridedSpan
+{
+public:
+
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using Size = std::size_t;
+
+    /**
+     * @brief The constructor of an empty span.
+     */
+    constexpr StridedSpan() noexcept
+        : p_data{nullptr}
+        , p_size{0}
+        , p_stride{sizeof(T)}
+    {
+    }
+
+    /**
+     * @brief The constructor.
+     * @param data The begining of the first element.
+     * @param size The number of the elements.
+     * @param stride The distance between the begining of two consecutive elements in bytes (e.g., sizeof(Particle)).
+     */
+    constexpr StridedSpan(T * data, const Size size, const Size stride) noexcept
+        : p_data{data}
+        , p_size{size}
+        , p_stride{stride}
+    {
+    }
+
+    /**
+     * @brief The constructor of a contiguous view.
+     * @param span The contiguous span.
+     */
+    constexpr explicit StridedSpan(const Span<T> & span) noexcept
+        : p_data{span.data()}
+        , p_size{span.size()}
+        , p_stride{sizeof(T)}
+    {
+    }
+
+    /**
+     * @brief Gives the number of the elements.
+     */
+    constexpr Size size() const noexcept {
+        return p_size;
+    }
+
+    /**
+     * @brief Gives the distance between the begining of two consecutive elements in bytes.
+     */
+    constexpr Size stride() const noexcept {
+        return p_stride;
+    }
+
+    /**
+     * @brief Whether the span is empty or not.
+     */
+    constexpr bool empty() const noexcept {
+        return p_size == 0;
+    }
+
+    /**
+     * @brief Gives the begining of the element at the index.
+     * @note The index is not checked.
+     */
+    T * at(const Size index) const noexcept {
+        using Byte = std::conditional_t<std::is_const_v<T>, const unsigned char, unsigned char>;
+        return reinterpret_cast<T *>(reinterpret_cast<Byte *>(p_data) + index * p_stride);
+    }
+
+    /**
+     * @brief Gives the first value of the element at the index.
+     * @note The index is not checked.
+     */
+    T & operator[](const Size index) const noexcept {
+        return *at(index);
+    }
+
+private:
+
+    T * p_data;     // The begining of the first element.
+    Size p_size;    // The number of the elements.
+    Size p_stride;  // The distance between two consecutive elements in bytes.
+
+};
+
+} // namespace exporting
+
+#endif // SPAN_H
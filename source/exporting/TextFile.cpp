@@ -7,12 +7,118 @@
 //
 
 #include "file_system/FileRegistar.h"
+#include "file_system/WorkerPool.h"
 #include "TextFile.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace exporting {
 
 using SingleFile = file_system::SingleFile;
 
+namespace {
+
+#if defined(__linux__)
+/**
+ * @brief Copies the rest of a file to the end of another one, in the kernel if possible.
+ * @details Tries copy_file_range first, then sendfile, and finally falls back to large block read/write
+ *          for whatever is left (e.g., when the file systems or the append mode do not support the former).
+ * @param source The file descriptor of the source file.
+ * @param destination The file descriptor of the destination file.
+ * @return The number of copied bytes.
+ */
+std::size_t copyFileDescriptor(const int source, const int destination) {
+    struct stat status;
+    if (fstat(source, &status) != 0)
+        return 0;
+    auto remaining = static_cast<std::size_t>(status.st_size);
+    std::size_t copied = 0;
+    const auto advance = [&remaining, &copied](const ssize_t bytes) {
+        if (bytes <= 0)
+            return false;
+        copied += static_cast<std::size_t>(bytes);
+        remaining -= std::min(remaining, static_cast<std::size_t>(bytes));
+        return true;
+    };
+
+    while (remaining && advance(copy_file_range(source, nullptr, destination, nullptr, remaining, 0)));
+    while (remaining && advance(sendfile(destination, source, nullptr, remaining)));
+
+    std::vector<char> buffer(std::min<std::size_t>(remaining, 1 << 20));
+    while (remaining) {
+        const auto read = ::read(source, buffer.data(), std::min(remaining, buffer.size()));
+        if (read <= 0)
+            break;
+        for (ssize_t written = 0; written < read;) {
+            const auto result = ::write(destination, buffer.data() + written, static_cast<std::size_t>(read - written));
+            if (result <= 0)
+                return copied;
+            written += result;
+        }
+        advance(read);
+    }
+    return copied;
+}
+
+/**
+ * @brief Writes chars to a file at an offset.
+ * @param destination The file descriptor of the destination file.
+ * @param data The begining of the chars.
+ * @param size The number of the chars.
+ * @param offset The offset to write at, advanced by the number of the written chars.
+ * @return True if all the chars are written, false otherwise.
+ */
+bool writeAt(const int destination, const char * data, std::size_t size, off_t & offset) {
+    while (size) {
+        const auto written = pwrite(destination, data, size, offset);
+        if (written <= 0)
+            return false;
+        data += written;
+        size -= static_cast<std::size_t>(written);
+        offset += written;
+    }
+    return true;
+}
+
+/**
+ * @brief Copies the begining of a file to another one at an offset, in the kernel if possible.
+ * @param source The file descriptor of the source file.
+ * @param size The number of bytes to copy.
+ * @param destination The file descriptor of the destination file.
+ * @param offset The offset to write at, advanced by the number of the copied bytes.
+ * @return True if all the bytes are copied, false otherwise.
+ */
+bool copyAt(const int source, std::size_t size, const int destination, off_t & offset) {
+    off_t sourceOffset = 0;
+    while (size) {
+        const auto copied = copy_file_range(source, &sourceOffset, destination, &offset, size, 0);
+        if (copied <= 0)
+            break;
+        size -= static_cast<std::size_t>(copied);
+    }
+
+    std::vector<char> buffer(std::min<std::size_t>(size, 1 << 20));
+    while (size) {
+        const auto read = pread(source, buffer.data(), std::min(size, buffer.size()), sourceOffset);
+        if (read <= 0 || !writeAt(destination, buffer.data(), static_cast<std::size_t>(read), offset))
+            return false;
+        sourceOffset += read;
+        size -= static_cast<std::size_t>(read);
+    }
+    return true;
+}
+#endif
+
+} // namespace
+
 TextFile::TextFile(const std::string &name, const std::string &extension)
     : SingleFile(name, extension)
 {
@@ -24,26 +130,103 @@ TextFile::TextFile(const std::string &path, const std::string &name, const std::
 }
 
 TextFile::CharCount TextFile::append(const char *c_str) {
-    if(!isOpen())
-        open(false);
-    return std::fputs(c_str, filePtr());
+    return static_cast<CharCount>(write(c_str, std::strlen(c_str)));
 }
 
 TextFile::CharCount TextFile::append(const std::string &str) {
-    return append(str.c_str());
+    return static_cast<CharCount>(write(str.data(), str.size()));
+}
+
+bool TextFile::appendContent(const file_system::SingleFile &other) {
+    if (other.isSpilled() && !appendFileContent(other.fullName(true)))
+        return false;
+    const auto & buffer = other.buffer();
+    return write(buffer.data(), buffer.size()) == buffer.size();
 }
 
-bool TextFile::appendFileContent(const std::string &filePath) {
-    unsigned long addedChars = 0;
-    char buffer[1024];
-    auto otherFile = file_system::FileRegistar::current().open(filePath.c_str(), "r");
+bool TextFile::appendFileContent(const std::string & filePath) {
+    std::size_t addedChars = 0;
+    auto otherFile = file_system::FileRegistar::current().open(filePath.c_str(), "rb");
+    if (otherFile) {
+#if defined(__linux__)
+        if (!isOpen())
+            open(false); // The content is copied behind the stream's back, so the file should be there.
+        if (flushBuffer() && acquire()) {
+            if (std::fflush(filePtr()) == 0) {
+                addedChars = copyFileDescriptor(fileno(otherFile), fileno(filePtr()));
+                std::fseek(filePtr(), 0, SEEK_END); // Let the stream know about the content written behind its back.
+            }
+            release();
+        }
+#else
+        char buffer[1 << 16];
+        while (const auto read = std::fread(buffer, 1, sizeof(buffer), otherFile))
+            addedChars += write(buffer, read);
+#endif
+        file_system::FileRegistar::current().close(otherFile);
+    }
+    return addedChars;
+}
+
+bool TextFile::appendBlocks(const std::vector<TextFile::Block> &blocks) {
+#if defined(__linux__)
+    // The offset of each block, relative to the current end of the file.
+    std::vector<std::size_t> spilled(blocks.size(), 0);
+    std::vector<off_t> offsets(blocks.size() + 1, 0);
+    for (std::size_t i = 0; i < blocks.size(); i++) {
+        const auto & block = blocks[i];
+        struct stat status;
+        if (block.content && block.content->isSpilled()) {
+            if (stat(block.content->fullName(true).c_str(), &status) != 0)
+                return false;
+            spilled[i] = static_cast<std::size_t>(status.st_size);
+        }
+        const auto buffered = (block.content) ? block.content->buffer().size() : 0;
+        offsets[i + 1] = offsets[i] + static_cast<off_t>(block.head.size() + spilled[i] + buffered + block.tail.size());
+    }
+
     if (!isOpen())
         open(false);
-    if (otherFile)
-        while (std::fgets(buffer, sizeof(buffer), otherFile))
-            addedChars += std::fputs(buffer, filePtr());
-    file_system::FileRegistar::current().close(otherFile);
-    return addedChars;
+    if (!flushBuffer() || !acquire())
+        return false;
+    struct stat status;
+    const auto output = (std::fflush(filePtr()) == 0 && fstat(fileno(filePtr()), &status) == 0)
+            ? file_system::FileRegistar::current().open(fullName(true).c_str(), "r+b") : nullptr;
+    std::atomic<bool> successful{output && ftruncate(fileno(output), status.st_size + offsets.back()) == 0};
+    if (successful) {
+        const auto destination = fileno(output);
+        file_system::WorkerPool::current().run(blocks.size(), [&](const std::size_t i) {
+            const auto & block = blocks[i];
+            auto offset = status.st_size + offsets[i];
+            auto done = writeAt(destination, block.head.data(), block.head.size(), offset);
+            if (done && spilled[i]) {
+                const auto source = file_system::FileRegistar::current().open(block.content->fullName(true).c_str(), "rb");
+                done = source && copyAt(fileno(source), spilled[i], destination, offset);
+                file_system::FileRegistar::current().close(source);
+            }
+            if (done && block.content)
+                done = writeAt(destination, block.content->buffer().data(), block.content->buffer().size(), offset);
+            if (done)
+                done = writeAt(destination, block.tail.data(), block.tail.size(), offset);
+            if (!done)
+                successful = false;
+        });
+    }
+    file_system::FileRegistar::current().close(output);
+    std::fseek(filePtr(), 0, SEEK_END); // Let the stream know about the content written behind its back.
+    release();
+    return successful;
+#else
+    if (!isOpen())
+        open(false);
+    for (const auto & block : blocks) {
+        if (write(block.head.data(), block.head.size()) != block.head.size()
+                || (block.content && !appendContent(*block.content))
+                || write(block.tail.data(), block.tail.size()) != block.tail.size())
+            return false;
+    }
+    return true;
+#endif
 }
 
 bool TextFile::nextLine()
@@ -9,9 +9,12 @@
 #ifndef TEXTFILES_H
 #define TEXTFILES_H
 
+#include "NumberFormat.h"
 #include "file_system/SingleFile.h"
 #include <iomanip>
 #include <sstream>
+#include <stdexcept>
+#include <vector>
 
 /**
  * The exporting namespace provides the means to handle exporting simulation data to files.
@@ -29,6 +32,15 @@ public:
 
     using CharCount = int;
 
+    /**
+     * @brief The Block struct provides a part of the content appended by appendBlocks.
+     */
+    struct Block {
+        std::string head;                           // The text before the content.
+        const file_system::SingleFile * content;    // The other file, if any (its spilled part, then its buffer).
+        std::string tail;                           // The text after the content.
+    };
+
     /**
      * @brief The constructor.
      * @param name The name of the file (the path to the file included).
@@ -62,6 +74,7 @@ public:
 
     /**
      * @brief Appends a number to the text file.
+     * @note Prefer the NumberFormat overload to resolve the format once for many numbers.
      * @tparam N The number type.
      * @param number The number.
      * @param scientific Whether print the number with schientific notation or not.
@@ -70,16 +83,44 @@ public:
      */
     template<typename N>
     CharCount appendNumber(const N number, bool scientific = false, int precision = -1){
-        const auto type = (scientific) ? "e" : "f";
-        const unsigned int defaultPrecision = (typeid(N) == typeid(double)) ? 12 : ((typeid (N) == typeid(float)) ? 6: 0);
-        const unsigned int finalPercision = (precision < 0) ? defaultPrecision : precision;
-        const auto str = "%." + std::to_string(finalPercision) + type;
-
-        if(!isOpen())
-            open(false);
-        if (isZero(number))
-            return std::fprintf(filePtr(), str.c_str(), static_cast<double>(0));
-        return std::fprintf(filePtr(), str.c_str(), static_cast<double>(number));
+        return appendNumber(number, NumberFormat::of<N>(scientific, precision));
+    }
+
+    /**
+     * @brief Appends a number to the text file.
+     * @tparam N The number type.
+     * @param number The number.
+     * @param format The notation and precision of the number.
+     * @return The number of characters successfully added to the file.
+     */
+    template<typename N>
+    CharCount appendNumber(const N number, const NumberFormat & format){
+        char text[NumberFormat::maxLength];
+        return static_cast<CharCount>(write(text, format.write(text, text + sizeof(text), number) - text));
+    }
+
+    /**
+     * @brief Appends the raw bytes of an array of numbers to the file.
+     * @tparam N The number type.
+     * @param numbers The begining of the array.
+     * @param count The number of the numbers.
+     * @param format The binary format (i.e., storage type and byte order) of the numbers.
+     * @return The number of bytes successfully added to the file.
+     * @throws If the format is not binary.
+     */
+    template<typename N>
+    Size appendBinary(const N * numbers, const Size count, const NumberFormat & format){
+        if (!format.isBinary())
+            throw std::logic_error("Only the binary formats can be appended as raw bytes.");
+        constexpr Size blockSize = 1 << 13;
+        char block[blockSize * sizeof(double)];
+        const auto perBlock = sizeof(block) / NumberFormat::sizeOf(format.storage());
+        Size ans = 0;
+        for (Size done = 0; done < count; done += perBlock) {
+            const auto size = (count - done < perBlock) ? count - done : perBlock;
+            ans += write(block, format.write(block, numbers + done, size) - block);
+        }
+        return ans;
     }
 
     /**
@@ -95,37 +136,38 @@ public:
         return append(osContent.str().c_str());
     }
 
+    /**
+     * @brief Appends the content of another file, including the part that is only kept in its memory.
+     * @note The other file should be saved beforehand, if its content is spilled to the file system.
+     * @param other The other file.
+     * @return True, if successful, false otherwise.
+     */
+    bool appendContent(const file_system::SingleFile & other);
+
     /**
      * @brief Appends the content of the given file.
+     * @note The content is copied byte by byte, so the binary files can be appended as well.
+     * @note On linux the content is copied in the kernel (i.e., copy_file_range or sendfile) when possible.
      * @param filePath The complete path to the other file.
      * @return True, if successful, false otherwise.
      */
     bool appendFileContent(const std::string & filePath);
 
     /**
-     * @brief Gos to a new line.
+     * @brief Appends the blocks one after the other, each block written independently at its offset.
+     * @note The other files should be saved beforehand, if their content is spilled to the file system.
+     * @note On linux the blocks are written in parallel by the WorkerPool (i.e., pwrite and copy_file_range at the offsets
+     *       computed from the blocks' sizes), otherwise they are appended one after the other.
+     * @param blocks The blocks.
      * @return True, if successful, false otherwise.
      */
-    bool nextLine();
-
-private:
+    bool appendBlocks(const std::vector<Block> & blocks);
 
     /**
-     * @brief Whether the value is close enoght to zero or not.
-     * @param value The value to check.
-     * @return True, if the value is close to zero false otherwise.
+     * @brief Gos to a new line.
+     * @return True, if successful, false otherwise.
      */
-    template<typename T>
-    constexpr bool isZero(T value) {
-        constexpr auto abs = [](const T & p) { return (p >= 0)? p : -p;};
-        if (value == 0)
-            return true;
-        if (typeid(T) == typeid(double))
-            return abs(value) <= 0.00000000001;
-        if (typeid(T) == typeid(float))
-            return abs(value) <= 0.00001f;
-        return value == 0;
-    }
+    bool nextLine();
 
 };
 
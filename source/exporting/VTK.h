@@ -9,8 +9,15 @@
 #ifndef VTK_H
 #define VTK_H
 
+#include "PVTUFile.h"
 #include "VTKFile.h"
 #include "VTKFileSeries.h"
+#include "VTKHDFFile.h"
+#include "VTKRectilinearGridFile.h"
+#include "VTKStructuredGridFile.h"
+#include "VTKStructuredPointsFile.h"
+#include "VTKWriterThread.h"
+#include "VTUFile.h"
 
 /**
  * The file_system namespace provides the means to handle files on the operating system file system.
@@ -24,10 +31,21 @@ namespace vtk {
 
 using File = VTKFile;
 using Point = VTKFile::Point;
+using Point3 = VTKFile::Point3;
 using Cell = VTKCell;
 using AttSource = VTKAttributeSection::SourceType;
 using AttType = VTKAttributeSection::AttributeType;
 using FileSeries = VTKFileSeries;
+#ifdef EXPORTING_WITH_HDF5
+using HDFFile = VTKHDFFile;
+#endif
+using ParallelUnstructuredFile = PVTUFile;
+using RectilinearGridFile = VTKRectilinearGridFile;
+using Shard = VTKShard;
+using StructuredGridFile = VTKStructuredGridFile;
+using StructuredPointsFile = VTKStructuredPointsFile;
+using UnstructuredFile = VTUFile;
+using WriterThread = VTKWriterThread;
 
 } // namespace vtk
 
@@ -0,0 +1,136 @@
+//
+//  VTKAttributeFile.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "VTKAttributeFile.h"
+#include <stdexcept>
+
+namespace exporting {
+
+VTKAttributeFile::VTKAttributeFile(const std::string &name, const std::string &extension)
+    : TextFile{name, extension}
+    , p_attributeSections{}
+    , p_dataTitle{"Very important data."}
+    , p_encoding{Encoding::Ascii}
+    , p_spillThreshold{VTKSection::defaultSpillThreshold}
+{
+}
+
+VTKAttributeFile::VTKAttributeFile(VTKAttributeFile &&other)
+    : TextFile{other.name(true), other.extension()}
+    , p_attributeSections{std::move(other.p_attributeSections)}
+    , p_dataTitle{other.p_dataTitle}
+    , p_encoding{other.p_encoding}
+    , p_spillThreshold{other.p_spillThreshold}
+{
+    other.p_attributeSections.clear();
+}
+
+VTKAttributeFile::Encoding VTKAttributeFile::encoding() const {
+    return p_encoding;
+}
+
+bool VTKAttributeFile::remove() {
+    return removeTemperoryFiles() || TextFile::remove();
+}
+
+bool VTKAttributeFile::save() {
+    for (auto & attributeSection : p_attributeSections)
+        if( !attributeSection.second->save() )
+            return false;
+    return true;
+}
+
+void VTKAttributeFile::setDataTitle(const std::string &title) {
+    if (title.length() < 150)
+        p_dataTitle = title;
+    else
+        p_dataTitle = title.substr(0, 146) + "...";
+}
+
+void VTKAttributeFile::setEncoding(const VTKAttributeFile::Encoding encoding) {
+    for (auto & attributeSection : p_attributeSections)
+        attributeSection.second->setEncoding(encoding);
+    p_encoding = encoding;
+}
+
+void VTKAttributeFile::setSpillThreshold(const VTKAttributeFile::Size threshold) {
+    for (auto & attributeSection : p_attributeSections)
+        attributeSection.second->setSpillThreshold(threshold);
+    p_spillThreshold = threshold;
+}
+
+const VTKAttributeSection &VTKAttributeFile::operator[](const std::string &name) const {
+    return *p_attributeSections.at(name);
+}
+
+VTKAttributeSection &VTKAttributeFile::operator[](const std::string &name) {
+    const auto itr = p_attributeSections.find(name);
+    if (itr == p_attributeSections.end()) {
+        p_attributeSections[name] = std::make_shared<VTKAttributeSection>(
+                    this->name(true),
+                    name,
+                    VTKAttributeSection::Scalar,
+                    VTKAttributeSection::SourceType::Point);
+        p_attributeSections[name]->setEncoding(p_encoding);
+        p_attributeSections[name]->setSpillThreshold(p_spillThreshold);
+    }
+    return *p_attributeSections[name];
+}
+
+const VTKAttributeFile::AttributeList &VTKAttributeFile::attributeSections() const {
+    return p_attributeSections;
+}
+
+const std::string &VTKAttributeFile::dataTitle() const {
+    return p_dataTitle;
+}
+
+VTKAttributeFile::Size VTKAttributeFile::spillThreshold() const {
+    return p_spillThreshold;
+}
+
+std::string VTKAttributeFile::fileHeader(const std::string &dataset) const {
+    return "# vtk DataFile Version 2.0\n" + dataTitle() + "\n"
+            + VTKSection::to_string(p_encoding) + "\n"
+            + "DATASET " + dataset + "\n";
+}
+
+void VTKAttributeFile::appendAttributeSections(const VTKAttributeFile::Size pointCount,
+                                               const VTKAttributeFile::Size cellCount) {
+    if (!TextFile::appendBlocks(VTKAttributeSection::assemblyBlocks(p_attributeSections, pointCount, cellCount)))
+        throw std::runtime_error("Could not append the content of the attribute sections.");
+}
+
+bool VTKAttributeFile::attributeSizesMatch(const VTKAttributeFile::Size pointCount,
+                                           const VTKAttributeFile::Size cellCount) const {
+    for (const auto & attributeSection : p_attributeSections) {
+        if (attributeSection.second->source() == VTKAttributeSection::SourceType::Point
+                && attributeSection.second->size() != pointCount)
+            return false;
+        else if (attributeSection.second->source() == VTKAttributeSection::SourceType::Cell
+                 && attributeSection.second->size() != cellCount)
+            return false;
+    }
+    return true;
+}
+
+void VTKAttributeFile::finishAssembly(const bool removeSections) {
+    if(removeSections)
+        if(!removeTemperoryFiles())
+            throw std::runtime_error("Could not remove the temp files (sections' bodies).");
+    close();
+}
+
+bool VTKAttributeFile::removeTemperoryFiles() {
+    for (auto & attributeSection : p_attributeSections)
+        if (!attributeSection.second->removeBody())
+            return false;
+    return true;
+}
+
+} // namespace exporting
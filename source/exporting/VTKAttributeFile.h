@@ -0,0 +1,182 @@
+//
+//  VTKAttributeFile.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef VTKATTRIBUTEFILE_H
+#define VTKATTRIBUTEFILE_H
+
+#include "TextFile.h"
+#include "vtk/VTKAttributeSection.h"
+#include <map>
+#include <memory>
+
+/**
+ * The exporting namespace provides the means to handle exporting simulation data to files.
+ */
+namespace exporting {
+
+/**
+ * @brief The VTKAttributeFile class is the base of the legacy vtk files, it holds their attribute sections along the
+ *        data title, the encoding, and the spill threshold shared by all the sections of the file.
+ * @details The derived classes provide the geometry of their dataset (e.g., the points and cells of an unstructured
+ *          grid) and append the attribute sections after it on assembly.
+ * @note The class is not default constructable.
+ */
+class VTKAttributeFile: public TextFile
+{
+public:
+
+    using Encoding = VTKSection::Encoding;
+    using Size = VTKSection::Size;
+
+    /**
+     * @brief The constructor.
+     * @param name The name of the file (the path to the file included).
+     * @param extension The extention of the file without the dot(.).
+     */
+    explicit VTKAttributeFile(const std::string &name,
+                              const std::string &extension = "vtk");
+
+    virtual ~VTKAttributeFile() = default;
+
+    void append(const std::string & text) = delete;
+    template<typename DATA>
+    void append(const DATA& data) = delete;
+    void nextLine() = delete;
+
+    /**
+     * @brief Gives the encoding of the file (i.e., ASCII or BINARY).
+     */
+    Encoding encoding() const;
+
+    /**
+     * @brief Assembles the sections headers and bodies to create the vtk file.
+     * @note The vtk file can be assembled any time if the sections are not removed.
+     * @param removeSections If true, removes the temp files of the section bodies afterward.
+     * @throws If the size of the sections' content are not compatible.
+     */
+    virtual void assemble(bool removeSections = true) = 0;
+
+    /**
+     * @brief Removes the file without move it to bin/trash directory.
+     * @return True if successful, false otherwise.
+     */
+    bool remove();
+
+    /**
+     * @brief Flushes the temp files of sections' bodies but keeps them open!
+     * @return True if successful, false otherwise.
+     */
+    virtual bool save();
+
+    /**
+     * @brief Sets the data title at the header of the vtk file.
+     * @note The title can be up to 150 character, more than that will be cut off.
+     * @param title The vtk title.
+     */
+    virtual void setDataTitle(const std::string & title);
+
+    /**
+     * @brief Sets the encoding of the file.
+     * @note Use this immediately after the constructor.
+     * @param encoding The new encoding.
+     * @throws If any of the sections' bodies is not empty.
+     */
+    virtual void setEncoding(const Encoding encoding);
+
+    /**
+     * @brief Sets the size of each section's body kept in memory before it is written to its temp file.
+     * @note The sections below the threshold are written to the vtk file straight from the memory on assembly.
+     * @param threshold The number of bytes (zero to write to the temp files right away).
+     */
+    virtual void setSpillThreshold(const Size threshold);
+
+    /**
+     * @brief Gives read-only access to attribute sections.
+     * @param name The name of the attribute.
+     */
+    const VTKAttributeSection & operator[](const std::string & name) const;
+
+    /**
+     * @brief Gives direct access to attribute section.
+     * @note It will create an attrubute section if not found.
+     * @param name The name of the attribute.
+     */
+    virtual VTKAttributeSection & operator[](const std::string & name);
+
+protected:
+
+    using AttributeList = std::map<std::string, std::shared_ptr<VTKAttributeSection> >;
+
+    /**
+     * @brief The move constructor, takes over the attribute sections of the other file.
+     * @note The other file continues with no attribute sections.
+     * @param other The file to take the attribute sections over from.
+     */
+    VTKAttributeFile(VTKAttributeFile && other);
+
+    /**
+     * @brief Gives the attribute sections of the file.
+     */
+    const AttributeList & attributeSections() const;
+
+    /**
+     * @brief Gives the data title at the header of the vtk file.
+     */
+    virtual const std::string & dataTitle() const;
+
+    /**
+     * @brief Gives the size of each section's body kept in memory before it is written to its temp file.
+     */
+    Size spillThreshold() const;
+
+    /**
+     * @brief Gives the header of the vtk file (i.e., the version, title, encoding, and dataset lines).
+     * @param dataset The name of the dataset (e.g., UNSTRUCTURED_GRID).
+     */
+    std::string fileHeader(const std::string & dataset) const;
+
+    /**
+     * @brief Appends the attribute sections, the sections are independent, they are written in parallel.
+     * @param pointCount The number of the points of the dataset.
+     * @param cellCount The number of the cells of the dataset.
+     * @throws If the content of the attribute sections could not be appended.
+     */
+    void appendAttributeSections(const Size pointCount, const Size cellCount);
+
+    /**
+     * @brief Computes whether the attribute sections' bodies have a compatible sizes with the dataset or not.
+     * @param pointCount The number of the points of the dataset.
+     * @param cellCount The number of the cells of the dataset.
+     */
+    bool attributeSizesMatch(const Size pointCount, const Size cellCount) const;
+
+    /**
+     * @brief Ends the assembly, removing the temp files of the section bodies if asked and closing the file.
+     * @param removeSections If true, removes the temp files of the section bodies.
+     * @throws If the temp files could not be removed.
+     */
+    void finishAssembly(const bool removeSections);
+
+    /**
+     * @brief Removes the temperory files related to this vtk (i.e., The section's bodies)
+     * @return True if successful, false otherwise.
+     */
+    virtual bool removeTemperoryFiles();
+
+private:
+
+    AttributeList p_attributeSections;
+    std::string p_dataTitle;    // The data title, at the header of the vtk file.
+    Encoding p_encoding;
+    Size p_spillThreshold;      // The size of each section's body kept in memory.
+
+};
+
+} // namespace exporting
+
+#endif // VTKATTRIBUTEFILE_H
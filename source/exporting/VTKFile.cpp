@@ -6,19 +6,36 @@
 //  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
 //
 
+#include "file_system/FileRegistar.h"
 #include "VTKFile.h"
+#include <algorithm>
+#include <mutex>
 
 namespace exporting {
 
+namespace {
+
+constexpr std::size_t pointCountWidth = 20; // The width of the point count placeholder, enough for any unsigned long.
+
+std::mutex geometryImageMutex;      // The files of a series may be assembled on the main thread and the IOQueue at once.
+std::size_t geometryImageCount = 0; // The number of the images created so far, so that each image has its own temp file.
+
+} // namespace
+
 VTKFile::VTKFile(const std::string &name, const std::string &extension)
-    : TextFile{name, extension}
-    , p_attributeSections{}
+    : VTKAttributeFile{name, extension}
     , p_cellSection{name}
     , p_cellTypeSection{name}
     , p_configuration{}
-    , p_dataTitle{"Very important data."}
+    , p_directWrite{false}
+    , p_pointCountOffset{0}
+    , p_handedOver{false}
     , p_locked{false}
+    , p_pointCloud{false}
     , p_pointSection{name}
+    , p_shards{}
+    , p_welder{}
+    , p_geometryImage{}
 {
 }
 
@@ -29,16 +46,145 @@ VTKFile::VTKFile(const std::string &path,
 {
 }
 
+VTKFile::VTKFile(VTKFile &&other)
+    : VTKAttributeFile{std::move(other)}
+    , p_cellSection{other.p_cellSection}
+    , p_cellTypeSection{other.p_cellTypeSection}
+    , p_configuration{other.p_configuration}
+    , p_directWrite{other.p_directWrite}
+    , p_pointCountOffset{other.p_pointCountOffset}
+    , p_handedOver{false}
+    , p_locked{other.p_locked}
+    , p_pointCloud{other.p_pointCloud}
+    , p_pointSection{other.p_pointSection}
+    , p_shards{std::move(other.p_shards)}
+    , p_welder{std::move(other.p_welder)}
+    , p_geometryImage{}
+{
+    // The sections are released, so the other file cannot touch their bodies anymore.
+    other.p_shards.clear();
+    other.p_cellSection.detachBody();
+    other.p_cellTypeSection.detachBody();
+    other.p_pointSection.detachBody();
+    other.p_handedOver = true;
+}
+
+bool VTKFile::isDirectWrite() const {
+    return p_directWrite;
+}
+
 bool VTKFile::isLocked() const {
     if(p_configuration)
         return p_configuration->p_locked;
     return p_locked;
 }
 
+bool VTKFile::isPointCloud() const {
+    return (p_configuration) ? p_configuration->isPointCloud() : p_pointCloud;
+}
+
 bool VTKFile::isSharingConfiguration() const {
     return static_cast<bool>(p_configuration);
 }
 
+VTKFile::Size VTKFile::shardCount() const {
+    return p_shards.size();
+}
+
+bool VTKFile::isWelding() const {
+    return (p_configuration) ? p_configuration->isWelding() : static_cast<bool>(p_welder);
+}
+
+void VTKFile::enableDirectWrite() {
+    if (p_directWrite)
+        return;
+    if (p_configuration)
+        throw std::logic_error("The points of a shared configuration cannot be streamed into the vtk file.");
+    const auto header = fileHeader();
+    p_pointSection.redirectBody(name(true), extension(), header + pointHeaderPlaceholder());
+    p_pointCountOffset = header.size() + std::string("POINTS ").size();
+    p_directWrite = true;
+}
+
+void VTKFile::enablePointCloud() {
+    if (p_locked)
+        throw std::runtime_error("The vtk configuration is blocked, you cannot append to it.");
+    if (p_configuration) {
+        p_configuration->enablePointCloud();
+    } else {
+        if (p_cellSection.cellCount())
+            throw std::logic_error("The point cloud cannot have explicit cells.");
+        p_pointCloud = true;
+    }
+}
+
+void VTKFile::enableWelding(const double tolerance) {
+    if (p_locked)
+        throw std::runtime_error("The vtk configuration is blocked, you cannot append to it.");
+    if (p_configuration)
+        p_configuration->enableWelding(tolerance);
+    else
+        p_welder = std::make_shared<VTKPointWelder>(tolerance);
+}
+
+void VTKFile::disableWelding() {
+    if (p_configuration)
+        p_configuration->disableWelding();
+    else
+        p_welder.reset();
+}
+
+void VTKFile::enableShards(const VTKFile::Size count) {
+    for (const auto & shard : p_shards)
+        if (!shard->empty())
+            throw std::logic_error("The shards should be merged before changing them.");
+    p_shards.resize(count);
+    for (auto & shard : p_shards)
+        if (!shard)
+            shard = std::make_shared<VTKShard>();
+}
+
+VTKShard &VTKFile::shard(const VTKFile::Size index) {
+    if (index >= p_shards.size())
+        throw std::out_of_range("The shard index is out of the shards of the vtk file.");
+    return *p_shards[index];
+}
+
+void VTKFile::mergeShards() {
+    std::vector<PointIndex> pointsMap;
+    std::vector<PointIndex> connectivity;
+    for (auto & shard : p_shards) {
+        if (shard->pointCount() || shard->cellCount()) {
+            if (isLocked())
+                throw std::runtime_error("The vtk configuration is blocked, you cannot append to it.");
+            checkShardCells(*shard);
+        }
+        // Once its points are appended, the shard is emptied even if the rest fails, so a retry does not repeat them.
+        try {
+            if (shard->pointCount() || shard->cellCount()) {
+                appendShardPoints(shard->points(), pointsMap);
+                // The vertices of the point cloud are implicit, only the explicit cells are appended.
+                if (!isPointCloud() && shard->cellCount()) {
+                    connectivity.resize(shard->connectivity().size());
+                    for (Size i = 0; i < connectivity.size(); i++)
+                        connectivity[i] = pointsMap[shard->connectivity()[i]];
+                    appendCells(shard->types(), shard->offsets(), connectivity);
+                }
+            }
+            for (const auto & attribute : shard->attributes<int>())
+                (*this)[attribute.first].appendAttribute(attribute.second);
+            for (const auto & attribute : shard->attributes<float>())
+                (*this)[attribute.first].appendAttribute(attribute.second);
+            for (const auto & attribute : shard->attributes<double>())
+                (*this)[attribute.first].appendAttribute(attribute.second);
+        } catch (...) {
+            shard->clear();
+            throw;
+        }
+        shard->clear();
+    }
+}
+
 void VTKFile::lock() {
     if(p_configuration)
         p_configuration->p_locked = true;
@@ -53,6 +199,7 @@ void VTKFile::appendCell(const VTKFile::CellType type,
     if (p_configuration) {
         p_configuration->appendCell(type, cellPointsMap);
     } else {
+        checkExplicitCells();
         p_cellSection.appendCell(type, cellPointsMap);
         p_cellTypeSection.appendCell(type);
     }
@@ -65,6 +212,19 @@ void VTKFile::appendCell(const VTKFile::CellType type,
 
     if (p_configuration) {
         p_configuration->appendCell(type, points);
+    } else if (p_pointCloud) {
+        checkImplicitVertex(type, points.size());
+        p_pointSection.appendPoint(points.front());
+    } else if (p_welder) {
+        std::vector<PointIndex> cellPointsMap;
+        cellPointsMap.reserve(points.size());
+        for (const auto & point : points) {
+            if (point.size() != 3)
+                throw std::range_error("The points of vtk has to have 3 dimensions (3D).");
+            cellPointsMap.emplace_back(appendWeldedPoint(point[0], point[1], point[2]));
+        }
+        p_cellSection.appendCell(type, cellPointsMap);
+        p_cellTypeSection.appendCell(type);
     } else {
         p_cellSection.appendCell(type, p_pointSection.appendPoints(points));
         p_cellTypeSection.appendCell(type);
@@ -80,18 +240,70 @@ void VTKFile::appendCell(const VTKFile::CellType type,
     if (p_configuration) {
         p_configuration->appendCell(type, points, cellPointsMap);
     } else {
+        checkExplicitCells();
         p_pointSection.appendPoints(points);
         p_cellSection.appendCell(type, cellPointsMap);
         p_cellTypeSection.appendCell(type);
     }
 }
 
+VTKFile::PointIndex VTKFile::appendPoints(Span<const double> xyz) {
+    if (p_locked)
+        throw std::runtime_error("The vtk configuration is blocked, you cannot append to it.");
+    return (p_configuration) ? p_configuration->appendPoints(xyz) : p_pointSection.appendPoints(xyz);
+}
+
+VTKFile::PointIndex VTKFile::appendPoints(Span<const double> x, Span<const double> y, Span<const double> z) {
+    if (p_locked)
+        throw std::runtime_error("The vtk configuration is blocked, you cannot append to it.");
+    return (p_configuration) ? p_configuration->appendPoints(x, y, z) : p_pointSection.appendPoints(x, y, z);
+}
+
+VTKFile::PointIndex VTKFile::appendPoints(StridedSpan<const double> points) {
+    if (p_locked)
+        throw std::runtime_error("The vtk configuration is blocked, you cannot append to it.");
+    return (p_configuration) ? p_configuration->appendPoints(points) : p_pointSection.appendPoints(points);
+}
+
+void VTKFile::appendCells(const VTKFile::CellType type,
+                          Span<const VTKFile::PointIndex> connectivity,
+                          const VTKFile::Size pointsPerCell) {
+    if (p_locked)
+        throw std::runtime_error("The vtk configuration is blocked, you cannot append to it.");
+
+    if (p_configuration) {
+        p_configuration->appendCells(type, connectivity, pointsPerCell);
+    } else {
+        checkExplicitCells();
+        const auto before = p_cellSection.cellCount();
+        p_cellTypeSection.appendCells(type, p_cellSection.appendCells(type, connectivity, pointsPerCell) - before);
+    }
+}
+
+void VTKFile::appendCells(Span<const VTKFile::CellType> types,
+                          Span<const VTKFile::PointIndex> offsets,
+                          Span<const VTKFile::PointIndex> connectivity) {
+    if (p_locked)
+        throw std::runtime_error("The vtk configuration is blocked, you cannot append to it.");
+
+    if (p_configuration) {
+        p_configuration->appendCells(types, offsets, connectivity);
+    } else {
+        checkExplicitCells();
+        p_cellSection.appendCells(types, offsets, connectivity);
+        p_cellTypeSection.appendCells(types);
+    }
+}
+
 void VTKFile::assemble(bool removeSections) {
+    checkSectionsOwned();
+    mergeShards();
     if (!sectionBodySizesMatch())
         throw std::runtime_error("The size of the sections' content are not compatible..");
 
-    const auto pointSize = p_cellSection.pointCount();
-    const auto cellSize = p_cellSection.cellCount();
+    const auto & source = (p_configuration) ? *p_configuration : *this;
+    const auto pointSize = source.p_pointSection.pointCount();
+    const auto cellSize = cellCount();
 
     try {
         assembleConfiguration(false);
@@ -102,75 +314,41 @@ void VTKFile::assemble(bool removeSections) {
                     allRemoved = remove();
 
         if (!allRemoved)
-            throw std::runtime_error("Could not remove the files (sections' boies).");
+            throw std::runtime_error("Could not remove the files (sections' bodies).");
         throw e.what();
     }
 
-    // Attribute Section
-    bool headerPrinted = false;
-    for (auto & attributeSection : p_attributeSections) {
-        if (attributeSection.second->source() == VTKAttributeSection::SourceType::Point) {
-            if(!headerPrinted) {
-                TextFile::append("POINT_DATA " + std::to_string(pointSize));
-                TextFile::nextLine();
-                headerPrinted = true;
-            }
-
-            if (!TextFile::append(attributeSection.second->header()) || !TextFile::nextLine())
-                throw std::runtime_error("Could not append the header of the attribute section.");
-
-            if (attributeSection.second->attributeType() == VTKAttributeSection::AttributeType::Scalar) {
-                TextFile::append("LOOKUP_TABLE default");
-                TextFile::nextLine();
-            }
-
-            if (!TextFile::appendFileContent(attributeSection.second->path()))
-                throw std::runtime_error("Could not append the body of the attribute section.");
-
-            if (attributeSection.second->body().columnCount() != 0)
-                TextFile::nextLine();
-        }
-        TextFile::nextLine();
-    }
-
-    headerPrinted = false;
-    for (auto & attributeSection : p_attributeSections) {
-        if (attributeSection.second->source() == VTKAttributeSection::SourceType::Cell) {
-            if(!headerPrinted) {
-                TextFile::append("CELL_DATA " + std::to_string(cellSize));
-                TextFile::nextLine();
-                headerPrinted = true;
-            }
-
-            if (!TextFile::append(attributeSection.second->header()) || !TextFile::nextLine())
-                throw std::runtime_error("Could not append the header of the attribute section.");
-
-            if (attributeSection.second->attributeType() == VTKAttributeSection::AttributeType::Scalar) {
-                TextFile::append("LOOKUP_TABLE default");
-                TextFile::nextLine();
-            }
-
-            if (!TextFile::appendFileContent(attributeSection.second->path()))
-                throw std::runtime_error("Could not append the body of the attribute section.");
-
-            if (attributeSection.second->body().columnCount() != 0)
-                TextFile::nextLine();
-        }
-        TextFile::nextLine();
+    appendAttributeSections(pointSize, cellSize);
+    finishAssembly(removeSections);
+    if (p_directWrite) {
+        patchPointCount();
+        lock();
     }
+}
 
-    if(removeSections && !p_configuration)
-        if(!removeTemperoryFiles())
-            throw std::runtime_error("Could not remove the temp files (sections' boies).");
-
-    close();
+std::future<void> VTKFile::assembleAsync(bool removeSections) {
+    if (p_locked)
+        throw std::logic_error("The vtk file is locked (e.g., already assembled), it cannot be assembled in background.");
+    if (p_configuration && !p_configuration->isLocked())
+        throw std::logic_error("The shared configuration should be locked before assembling the file in background.");
+    mergeShards();
+    saveSections();
+    const auto file = handOver();
+    lock();
+    return file_system::IOQueue::current().submit([file, removeSections]{
+        file->assemble(removeSections);
+    });
 }
 
 bool VTKFile::remove() {
-    return removeTemperoryFiles() || TextFile::remove();
+    if (p_handedOver)
+        return false; // The files belong to the file that took the sections over.
+    return VTKAttributeFile::remove();
 }
 
 bool VTKFile::save() {
+    if (p_handedOver)
+        return true; // The sections are saved before they are handed over.
     if (p_configuration) {
         p_cellSection.save();
         p_pointSection.save();
@@ -181,137 +359,322 @@ bool VTKFile::save() {
                 || !p_cellTypeSection.save() )
             return false;
     }
-    for (auto & attributeSection : p_attributeSections)
-        if( !attributeSection.second->save() )
-            return false;
-    return true;
+    return VTKAttributeFile::save();
+}
+
+void VTKFile::setEncoding(const VTKFile::Encoding encoding) {
+    if (p_directWrite)
+        throw std::logic_error("The encoding cannot be changed after the vtk header is written.");
+    if (encoding != this->encoding())
+        discardGeometryImage();
+    p_pointSection.setEncoding(encoding);
+    p_cellSection.setEncoding(encoding);
+    p_cellTypeSection.setEncoding(encoding);
+    VTKAttributeFile::setEncoding(encoding);
+}
+
+void VTKFile::setSpillThreshold(const VTKFile::Size threshold) {
+    p_pointSection.setSpillThreshold(threshold);
+    p_cellSection.setSpillThreshold(threshold);
+    p_cellTypeSection.setSpillThreshold(threshold);
+    VTKAttributeFile::setSpillThreshold(threshold);
 }
 
 void VTKFile::setDataTitle(const std::string &title) {
+    if (p_directWrite)
+        throw std::logic_error("The data title cannot be changed after the vtk header is written.");
     if (p_configuration) {
         p_configuration->setDataTitle(title);
     }
-    if (title.length() < 150)
-        p_dataTitle = title;
-    else
-        p_dataTitle = title.substr(0, 146) + "...";
+    discardGeometryImage();
+    VTKAttributeFile::setDataTitle(title);
 }
 
 void VTKFile::shareConfiguration(const std::shared_ptr<VTKFile> & file) {
+    if (p_directWrite)
+        throw std::logic_error("The vtk file streams its own points, it cannot share a configuration.");
     p_configuration = file;
 }
 
-const VTKAttributeSection &VTKFile::operator[](const std::string &name) const {
-    return *p_attributeSections.at(name);
+VTKAttributeSection &VTKFile::operator[](const std::string &name) {
+    if (p_locked)
+        throw std::runtime_error("The vtk file is locked, you cannot append attributes to it.");
+    return VTKAttributeFile::operator[](name);
 }
 
-VTKAttributeSection &VTKFile::operator[](const std::string &name) {
-    const auto itr = p_attributeSections.find(name);
-    if (itr == p_attributeSections.end()) {
-        p_attributeSections[name] = std::make_shared<VTKAttributeSection>(
-                    this->name(true),
-                    name,
-                    VTKAttributeSection::Scalar,
-                    VTKAttributeSection::SourceType::Point);
+void VTKFile::assembleConfiguration(bool block) {
+    const auto & source = (p_configuration) ? *p_configuration : *this;
+    if (source.encoding() != encoding())
+        throw std::runtime_error("The encoding of the shared configuration does not match the vtk file.");
+
+    if (p_directWrite) {
+        save(); // Flush the tempfiles and the points already streamed into the file.
+        if (!isOpen())
+            open(false);
+        appendGeometry(*this, false);
+    } else {
+        if (!isOpen())
+            open(true);
+        if (p_configuration && p_configuration->p_locked) {
+            // The locked configuration is assembled once, each file only copies it.
+            save(); // Flush the tempfiles, the configuration is flushed along its image.
+            const auto image = p_configuration->geometryImage(); // Kept alive even if the image is discarded meanwhile.
+            if (!TextFile::appendContent(*image))
+                throw std::runtime_error("Could not append the geometry of the shared configuration.");
+        } else {
+            saveSections(); // Flush the tempfiles.
+            source.appendGeometry(*this, true);
+        }
     }
-    return *p_attributeSections[name];
+
+    if (block && p_configuration)
+        p_configuration->lock();
 }
 
-void VTKFile::assembleConfiguration(bool block) {
-    if (!isOpen())
-        open(true);
+std::shared_ptr<VTKFile> VTKFile::handOver() {
+    return std::shared_ptr<VTKFile>(new VTKFile(std::move(*this)));
+}
 
-    if (p_configuration) {
-        p_configuration->save(); // Flush the tempfiles.
+const VTKCellSection &VTKFile::cellSection() const {
+    return (p_configuration) ? p_configuration->p_cellSection : p_cellSection;
+}
+
+void VTKFile::setCellIndexStorage(const VTKCellSection::Storage storage) {
+    p_cellSection.setIndexStorage(storage);
+}
+
+VTKFile::Size VTKFile::cellCount() const {
+    const auto & source = (p_configuration) ? *p_configuration : *this;
+    return (source.p_pointCloud) ? source.p_pointSection.pointCount() : source.p_cellSection.cellCount();
+}
+
+const VTKCellTypeSection &VTKFile::cellTypeSection() const {
+    return (p_configuration) ? p_configuration->p_cellTypeSection : p_cellTypeSection;
+}
+
+const std::string &VTKFile::dataTitle() const {
+    return (p_configuration) ? p_configuration->dataTitle() : VTKAttributeFile::dataTitle();
+}
+
+const VTKPointSection &VTKFile::pointSection() const {
+    return (p_configuration) ? p_configuration->p_pointSection : p_pointSection;
+}
+
+void VTKFile::saveSections() {
+    if (p_configuration)
+        p_configuration->save();
+    save();
+}
+
+std::string VTKFile::fileHeader() const {
+    return VTKAttributeFile::fileHeader("UNSTRUCTURED_GRID");
+}
+
+std::string VTKFile::pointHeaderPlaceholder() {
+    return "POINTS " + std::string(pointCountWidth, ' ') + " double\n";
+}
 
+void VTKFile::patchPointCount() {
+    const auto count = std::to_string(p_pointSection.pointCount());
+    auto file = file_system::FileRegistar::current().open(fullName(true).c_str(), "r+b");
+    if (!file)
+        throw std::runtime_error("Could not open the vtk file to patch the number of points.");
+    const auto patched = std::fseek(file, static_cast<long>(p_pointCountOffset), SEEK_SET) == 0
+            && std::fwrite(count.data(), sizeof(char), count.size(), file) == count.size();
+    file_system::FileRegistar::current().close(file);
+    if (!patched)
+        throw std::runtime_error("Could not patch the number of points of the vtk file.");
+}
+
+void VTKFile::appendGeometry(TextFile &target, const bool withPoints) const {
+    if (withPoints) {
         // header
-        TextFile::append("# vtk DataFile Version 2.0");
-        TextFile::nextLine();
-        TextFile::append(p_configuration->p_dataTitle);
-        TextFile::nextLine();
-        TextFile::append("ASCII");
-        TextFile::nextLine();
-        TextFile::append("DATASET UNSTRUCTURED_GRID");
-        TextFile::nextLine();
+        target.append(fileHeader());
 
         // Point Section
-        if (!TextFile::append(p_configuration->p_pointSection.header()) || !TextFile::nextLine()
-                || !TextFile::appendFileContent(p_configuration->p_pointSection.path()))
+        if (!target.append(p_pointSection.header()) || !target.nextLine()
+                || !target.appendContent(p_pointSection.body()))
             throw std::runtime_error("Could not append the content of the point section.");
-        if (p_configuration->p_pointSection.pointCount() % 3)
-            TextFile::nextLine();
-        TextFile::nextLine();
+    }
+    if (encoding() == Encoding::Ascii && p_pointSection.pointCount() % 3)
+        target.nextLine();
+    target.nextLine();
 
-        // Cell Section
-        if (!TextFile::append(p_configuration->p_cellSection.header()) || !TextFile::nextLine()
-                || !TextFile::appendFileContent(p_configuration->p_cellSection.path()))
+    // Cell Section
+    if (p_pointCloud) {
+        appendImplicitCells(target, p_pointSection.pointCount());
+    } else {
+        if (!target.append(p_cellSection.header()) || !target.nextLine()
+                || !target.appendContent(p_cellSection.body()))
             throw std::runtime_error("Could not append the content of the cell section.");
-        TextFile::nextLine();
+        target.nextLine();
+    }
 
-        // Cell_Type Section
-        if (!TextFile::append(p_configuration->p_cellTypeSection.header()) || !TextFile::nextLine()
-                || !TextFile::appendFileContent(p_configuration->p_cellTypeSection.path()))
-            throw std::runtime_error("Could not append the content of the cell type section.");
-        TextFile::nextLine();
+    // Cell_Type Section
+    appendCellTypes(target, (p_pointCloud) ? VTKCellTypeSection::Runs{{Cell::Vertex, p_pointSection.pointCount()}}
+                                           : p_cellTypeSection.runs());
+}
 
-        if (block)
-            p_configuration->lock();
-    } else {
+std::shared_ptr<const TextFile> VTKFile::geometryImage() {
+    std::lock_guard<std::mutex> guard(geometryImageMutex);
+    if (!p_geometryImage) {
         save(); // Flush the tempfiles.
+        // The temp file (if spilled) is removed along the image, once the last assembly using it lets go of it.
+        const auto name = this->name(true) + "_geometry_" + std::to_string(geometryImageCount++);
+        const auto image = std::shared_ptr<TextFile>(new TextFile(name, "tempvtk"), [](TextFile * file) {
+            file->remove();
+            delete file;
+        });
+        image->setSpillThreshold(spillThreshold());
+        image->setMemoryResident(true);
+        image->remove(); // The leftovers of any previous run should go.
+        appendGeometry(*image, true);
+        if (image->isSpilled() && !image->save())
+            throw std::runtime_error("Could not flush the geometry image of the configuration.");
+        p_geometryImage = image;
+    }
+    return p_geometryImage;
+}
 
-        // header
-        TextFile::append("# vtk DataFile Version 2.0");
-        TextFile::nextLine();
-        TextFile::append(p_dataTitle);
-        TextFile::nextLine();
-        TextFile::append("ASCII");
-        TextFile::nextLine();
-        TextFile::append("DATASET UNSTRUCTURED_GRID");
-        TextFile::nextLine();
+void VTKFile::discardGeometryImage() {
+    std::lock_guard<std::mutex> guard(geometryImageMutex);
+    p_geometryImage.reset(); // The assemblies in flight keep their copy of the image.
+}
 
-        // Point Section
-        if (!TextFile::append(p_pointSection.header()) || !TextFile::nextLine()
-                || !TextFile::appendFileContent(p_pointSection.path()))
-            throw std::runtime_error("Could not append the content of the point section.");
-        if (p_pointSection.pointCount() % 3)
-            TextFile::nextLine();
-        TextFile::nextLine();
+void VTKFile::appendCellTypes(TextFile &target, const VTKCellTypeSection::Runs &runs) const {
+    VTKCellTypeSection::Size count = 0;
+    for (const auto & run : runs)
+        count += run.count;
+    target.append("CELL_TYPES " + std::to_string(count));
+    target.nextLine();
+    const auto & format = cellTypeSection().format();
+    VTKCellTypeSection::expand(runs, [this, &target, &format](const Cell::Code * codes, const Size size) {
+        appendGeneratedRows(target, codes, size, 1, format);
+    });
+    target.nextLine();
+}
 
-        // Cell Section
-        if (!TextFile::append(p_cellSection.header()) || !TextFile::nextLine()
-                || !TextFile::appendFileContent(p_cellSection.path()))
-            throw std::runtime_error("Could not append the content of the cell section.");
-        TextFile::nextLine();
+void VTKFile::appendGeneratedRows(TextFile &target,
+                                  const unsigned long *values,
+                                  const VTKFile::Size count,
+                                  const VTKFile::Size rowSize,
+                                  const NumberFormat &format) const {
+    if (encoding() == Encoding::Binary) {
+        target.appendBinary(values, count, format);
+        return;
+    }
+    // The same text as the sections' bodies (i.e., each value followed by the seperator, unless it ends a one-value row).
+    char number[NumberFormat::maxLength];
+    std::string text;
+    text.reserve(count * 8);
+    for (Size i = 0; i < count; i++) {
+        text.append(number, format.write(number, number + sizeof(number), values[i]));
+        text += ((i + 1) % rowSize) ? " " : (rowSize == 1) ? "\n" : " \n";
+    }
+    target.append(text);
+}
 
-        // Cell_Type Section
-        if (!TextFile::append(p_cellTypeSection.header()) || !TextFile::nextLine()
-                || !TextFile::appendFileContent(p_cellTypeSection.path()))
-            throw std::runtime_error("Could not append the content of the cell type section.");
-        TextFile::nextLine();
+void VTKFile::appendImplicitCells(TextFile &target, const VTKFile::Size count) const {
+    // Each vertex is the number of its points (i.e., 1) followed by the index of its point.
+    constexpr Size blockSize = 1 << 12;
+    PointIndex values[2 * blockSize];
+    target.append("CELLS " + std::to_string(count) + " " + std::to_string(2 * count));
+    target.nextLine();
+    for (Size done = 0; done < count; done += blockSize) {
+        const auto size = std::min(count - done, blockSize);
+        for (Size i = 0; i < size; i++) {
+            values[2 * i] = 1;
+            values[2 * i + 1] = done + i;
+        }
+        appendGeneratedRows(target, values, 2 * size, 2, cellSection().format());
+    }
+    target.nextLine();
+}
+
+void VTKFile::checkSectionsOwned() const {
+    if (p_handedOver)
+        throw std::logic_error("The sections of the vtk file are handed over (i.e., it is assembled in background).");
+}
+
+void VTKFile::checkExplicitCells() const {
+    if (p_pointCloud)
+        throw std::logic_error("The cells of a point cloud are implicit, append the points instead.");
+}
+
+void VTKFile::checkImplicitVertex(const VTKFile::CellType type, const VTKFile::Size points) {
+    if (type != Cell::Vertex)
+        throw std::logic_error("Only the vertex cells can be appended to a point cloud.");
+    if (points != 1)
+        throw std::range_error("The vertex cell requires exactly one point.");
+}
+
+void VTKFile::checkShardCells(const VTKShard &shard) const {
+    const auto & offsets = shard.offsets();
+    for (Size i = 0; i < shard.cellCount(); i++) {
+        const auto type = shard.types()[i];
+        const auto size = offsets[i + 1] - offsets[i];
+        if (isPointCloud()) {
+            checkImplicitVertex(type, size);
+            continue;
+        }
+        if (size < Cell::minPoints(type))
+            throw std::range_error("The cell requires more point indexes.");
+        if (size > Cell::maxPoints(type))
+            throw std::range_error("The cell requires less point indexes.");
+        for (auto index = offsets[i]; index < offsets[i + 1]; index++)
+            if (shard.connectivity()[index] >= shard.pointCount())
+                throw std::range_error("A cell of the shard refers to a point out of the shard.");
+    }
+}
+
+VTKFile::PointIndex VTKFile::appendWeldedPoint(const double x, const double y, const double z) {
+    const auto ans = p_welder->weld(x, y, z, p_pointSection.pointCount());
+    if (ans.second)
+        p_pointSection.appendPoint(x, y, z);
+    return ans.first;
+}
+
+void VTKFile::appendShardPoints(Span<const double> xyz, std::vector<VTKFile::PointIndex> &pointsMap) {
+    if (p_locked)
+        throw std::runtime_error("The vtk configuration is blocked, you cannot append to it.");
+    if (p_configuration)
+        return p_configuration->appendShardPoints(xyz, pointsMap);
+
+    pointsMap.clear();
+    pointsMap.reserve(xyz.size() / 3);
+    if (p_welder) {
+        for (Size i = 0; i < xyz.size(); i += 3)
+            pointsMap.emplace_back(appendWeldedPoint(xyz[i], xyz[i + 1], xyz[i + 2]));
+    } else if (xyz.size()) {
+        const auto first = p_pointSection.appendPoints(xyz);
+        for (Size i = 0; i < xyz.size() / 3; i++)
+            pointsMap.emplace_back(first + i);
     }
 }
 
 bool VTKFile::removeTemperoryFiles() {
+    if (p_handedOver)
+        return true; // The temp files belong to the file that took the sections over.
+    discardGeometryImage();
     if (p_configuration) {
         p_cellSection.removeBody();
         p_pointSection.removeBody();
         p_cellTypeSection.removeBody();
     } else {
         if (!p_cellSection.removeBody()
-                || !p_pointSection.removeBody()
+                || (!p_directWrite && !p_pointSection.removeBody())
                 || !p_cellTypeSection.removeBody() )
             return false;
     }
-    for (auto & attributeSection : p_attributeSections)
-        if (!attributeSection.second->removeBody())
-            return false;
-    return true;
+    return VTKAttributeFile::removeTemperoryFiles();
 }
 
 bool VTKFile::sectionBodySizesMatch() {
     const auto pointSize = (p_configuration)? p_configuration->p_pointSection.pointCount() : p_pointSection.pointCount();
-    const auto cellSize = (p_configuration)? p_configuration->p_cellSection.cellCount() : p_cellSection.cellCount();
-    if (p_configuration) {
+    const auto cellSize = cellCount();
+    if (isPointCloud()) {
+        // The cells are generated on assembly.
+    } else if (p_configuration) {
         if (p_configuration->p_cellSection.pointCount() < pointSize
                 || p_configuration->p_cellTypeSection.cellCount() != cellSize)
             return false;
@@ -320,15 +683,7 @@ bool VTKFile::sectionBodySizesMatch() {
                 || p_cellTypeSection.cellCount() != cellSize)
             return false;
     }
-    for (const auto & attributeSection : p_attributeSections) {
-        if (attributeSection.second->source() == VTKAttributeSection::SourceType::Point
-                && attributeSection.second->size() != pointSize)
-            return false;
-        else if (attributeSection.second->source() == VTKAttributeSection::SourceType::Cell
-                 && attributeSection.second->size() != cellSize)
-            return false;
-    }
-    return true;
+    return attributeSizesMatch(pointSize, cellSize);
 }
 
 } // namespace exporting
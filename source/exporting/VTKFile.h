@@ -9,13 +9,16 @@
 #ifndef VTKFILE_H
 #define VTKFILE_H
 
-#include "TextFile.h"
-#include "vtk/VTKAttributeSection.h"
+#include "file_system/IOQueue.h"
+#include "VTKAttributeFile.h"
 #include "vtk/VTKCell.h"
 #include "vtk/VTKCellSection.h"
 #include "vtk/VTKCellTypeSection.h"
 #include "vtk/VTKPointSection.h"
-#include <map>
+#include "vtk/VTKPointWelder.h"
+#include "vtk/VTKShard.h"
+#include <initializer_list>
+#include <memory>
 #include <vector>
 
 /**
@@ -23,7 +26,7 @@
  */
 namespace exporting {
 
-class VTKFile: public TextFile
+class VTKFile: public VTKAttributeFile
 {
 public:
 
@@ -32,6 +35,7 @@ public:
     using CellType = VTKCell::Type;
     using CellPointIndex = unsigned long;
     using Point = std::vector<double>;
+    using Point3 = VTKPointSection::Point3;
     using PointIndex = unsigned long;
 
     /**
@@ -53,21 +57,111 @@ public:
                      const std::string &name,
                      const std::string &extension);
 
-    void append(const std::string & text) = delete;
-    template<typename DATA>
-    void append(const DATA& data) = delete;
-    void nextLine() = delete;
+    /**
+     * @brief Whether the points are streamed straight into the vtk file or not.
+     */
+    bool isDirectWrite() const;
 
     /**
      * @brief Whether the configuration is locked or not.
      */
     bool isLocked() const;
 
+    /**
+     * @brief Whether the file is a point cloud (i.e., one implicit vertex cell per point) or not (see enablePointCloud).
+     */
+    bool isPointCloud() const;
+
     /**
      * @brief Whether the file exporting data on the initial configuration or not.
      */
     bool isSharingConfiguration() const;
 
+    /**
+     * @brief Gives the number of the shards (see enableShards).
+     */
+    Size shardCount() const;
+
+    /**
+     * @brief Whether the points of the cells appended with their coordinates are welded or not (see enableWelding).
+     */
+    bool isWelding() const;
+
+    /**
+     * @brief Streams the points straight into the vtk file, instead of the temp file of the point section.
+     * @details The vtk header is written right away with a fixed-width placeholder for the number of points,
+     *          which is patched on assembly. The points are therefore written only once, while the other sections
+     *          are appended from their (in memory) bodies.
+     * @note Use this immediately after the constructor, after setting the encoding and the data title; neither can be
+     *       changed afterward.
+     * @note The file can be assembled only once, the configuration is locked afterward.
+     * @throws If the configuration is shared or the point section is not empty.
+     */
+    void enableDirectWrite();
+
+    /**
+     * @brief Exports the file as a point cloud, where each point is a vertex cell.
+     * @details The vertex cells are fully implied by the points, so they are not stored on the cell and cell_type
+     *          sections; the connectivity and the types are generated on the fly on assembly. Append the points
+     *          (see appendPoints) or the vertex cells with their coordinates (e.g., appendCell(Cell::Vertex, {point})).
+     * @note Applies on the shared configuration, if any.
+     * @throws If the configuration is locked.
+     * @throws If the configuration already has cells.
+     */
+    void enablePointCloud();
+
+    /**
+     * @brief Welds the points of the cells appended with their coordinates (i.e., without a points map) to the
+     *        already appended points having the same coordinates, instead of appending them again.
+     * @details The shared nodes of the cells (e.g., up to 8 times in a hexahedral mesh) are appended only once and
+     *          the connectivity of the cells points to the shared indexes (see VTKPointWelder).
+     * @note The points appended before this call, or along with a points map, are not welded.
+     * @note Applies on the shared configuration, if any.
+     * @param tolerance The size of the box that the coordinates are quantised to, zero for the exact coordinates.
+     * @throws If the configuration is locked.
+     * @throws If the tolerance is negative.
+     */
+    void enableWelding(const double tolerance = 0);
+
+    /**
+     * @brief Stops welding the points and releases the welding hash map.
+     * @note Applies on the shared configuration, if any.
+     */
+    void disableWelding();
+
+    /**
+     * @brief Creates the shards that the threads of the simulation append to concurrently (e.g., one per OpenMP thread).
+     * @details Each thread appends its points, cells, and attributes to its own shard in memory without any lock.
+     *          The shards are merged into the sections in the order of their indexes (i.e., deterministically) by
+     *          mergeShards, which is called by assemble as well.
+     * @note The content of the shards is merged after the content appended to the file itself.
+     * @param count The number of the shards.
+     * @throws If the shards holds content that is not merged yet.
+     */
+    void enableShards(const Size count);
+
+    /**
+     * @brief Gives a shard of the file (see enableShards).
+     * @note The shards can be used concurrently, but the file should not be appended to meanwhile.
+     * @param index The index of the shard (e.g., omp_get_thread_num()).
+     * @return The shard.
+     * @throws If the index is out of the shards.
+     */
+    VTKShard & shard(const Size index);
+
+    /**
+     * @brief Merges the content of the shards into the sections, one shard after the other, and empties the shards.
+     * @details The points of each shard are appended at once (and welded, if the welding is enabled), the point indexes
+     *          of its cells are remapped to the appended points, and its attribute values are appended to the attribute
+     *          sections of the same name.
+     * @note Should not be called while the shards are being appended to.
+     * @note The cells of a shard are validated before its points are appended, a shard failing the validation is left
+     *       untouched (along the later shards), while a shard failing afterward (e.g., on its attributes) is emptied.
+     * @throws If a cell of a shard refers to a point out of the shard or has a wrong number of points.
+     * @throws If the configuration is locked and a shard holds points or cells.
+     */
+    void mergeShards();
+
     /**
      * @brief Locks the configuration of the file.
      */
@@ -110,13 +204,180 @@ public:
                     const std::vector<Point> & points,
                     const std::vector<PointIndex> & cellPointsMap);
 
+    /**
+     * @brief Append a cell to the vtk sections' body's files (temp files) without any heap allocation.
+     * @note This will not add points to the point section and maps them to the new cell.
+     * @tparam POINTS An iterable of fixed-size points having the VTKPointTraits (e.g., std::vector<Point3>).
+     * @param type The type of the cell.
+     * @param points The location of cell's vertices.
+     * @throws If the number of points is not in the acceptable range.
+     * @throws If the configuration is locked.
+     */
+    template<typename POINTS, typename = std::enable_if_t<isVTKPointRange<POINTS>::value> >
+    void appendCell(const CellType type,
+                    const POINTS & points) {
+        if (p_locked)
+            throw std::runtime_error("The vtk configuration is blocked, you cannot append to it.");
+
+        if (p_configuration) {
+            p_configuration->appendCell(type, points);
+        } else if (p_pointCloud) {
+            checkImplicitVertex(type, std::size(points));
+            p_pointSection.appendPoint(*std::begin(points));
+        } else if (p_welder) {
+            constexpr std::size_t stackSize = 32;
+            PointIndex stack[stackSize];
+            std::vector<PointIndex> heap(std::size(points) > stackSize ? std::size(points) : 0);
+            const auto cellPointsMap = (heap.empty()) ? stack : heap.data();
+            std::size_t size = 0;
+            for (const auto & point : points) {
+                using Traits = VTKPointTraits<std::decay_t<decltype(point)> >;
+                cellPointsMap[size++] = appendWeldedPoint(Traits::x(point), Traits::y(point), Traits::z(point));
+            }
+            p_cellSection.appendCell(type, Span<const PointIndex>(cellPointsMap, size));
+            p_cellTypeSection.appendCell(type);
+        } else {
+            const auto first = p_pointSection.pointCount();
+            for (const auto & point : points)
+                p_pointSection.appendPoint(point);
+            p_cellSection.appendCell(type, first, std::size(points));
+            p_cellTypeSection.appendCell(type);
+        }
+    }
+
+    /**
+     * @brief Append a cell to the vtk sections' body's files (temp files) without any heap allocation.
+     * @note This will not add points to the point section and maps them to the new cell.
+     * @note Allows the brace-enclosed points, e.g., appendCell(Cell::Line, {point0, point1}).
+     * @tparam POINT A fixed-size point having the VTKPointTraits (e.g., Point3).
+     * @param type The type of the cell.
+     * @param points The location of cell's vertices.
+     * @throws If the number of points is not in the acceptable range.
+     * @throws If the configuration is locked.
+     */
+    template<typename POINT, typename = std::enable_if_t<VTKPointTraits<POINT>::isPoint> >
+    void appendCell(const CellType type,
+                    std::initializer_list<POINT> points) {
+        appendCell<std::initializer_list<POINT> >(type, points);
+    }
+
+    /**
+     * @brief Append a cell to the vtk sections' body's files (temp files).
+     * @note This will not new point(s) to the point section but does not maps them to the new cell automaticly.
+     * @note The points can be added afterward by other cells too.
+     * @note The map should be complete (including the current added points)
+     * @tparam POINTS An iterable of fixed-size points having the VTKPointTraits (e.g., std::vector<Point3>).
+     * @param type The type of the cell.
+     * @param points The location of cell's vertices.
+     * @param cellPointsMap The points-vertices map of the cell.
+     * @throws If the number of points on the map is not in the acceptable range.
+     * @throws If the configuration is locked.
+     */
+    template<typename POINTS, typename = std::enable_if_t<isVTKPointRange<POINTS>::value> >
+    void appendCell(const CellType type,
+                    const POINTS & points,
+                    const std::vector<PointIndex> & cellPointsMap) {
+        if (p_locked)
+            throw std::runtime_error("The vtk configuration is blocked, you cannot append to it.");
+
+        if (p_configuration) {
+            p_configuration->appendCell(type, points, cellPointsMap);
+        } else {
+            checkExplicitCells();
+            for (const auto & point : points)
+                p_pointSection.appendPoint(point);
+            p_cellSection.appendCell(type, cellPointsMap);
+            p_cellTypeSection.appendCell(type);
+        }
+    }
+
+    /**
+     * @brief Append packed points to the vtk point section's body's file (temp file) without copying them.
+     * @note The points are not mapped to any cell (see appendCells).
+     * @param xyz The dimension of the points in sereis (i.g., x_0, y_0, z_0, x_1, y_1, ...).
+     * @return The index of the first added point (i.e., the points have consecutive indexes).
+     * @throws If the dimensions size is not a factor of 3.
+     * @throws If the configuration is locked.
+     */
+    PointIndex appendPoints(Span<const double> xyz);
+
+    /**
+     * @brief Append points stored as structure of arrays (SoA) to the vtk point section's body's file (temp file) without copying them.
+     * @note The points are not mapped to any cell (see appendCells).
+     * @param x The x of the points.
+     * @param y The y of the points.
+     * @param z The z of the points.
+     * @return The index of the first added point (i.e., the points have consecutive indexes).
+     * @throws If the sizes of the x, y, and z are not the same.
+     * @throws If the configuration is locked.
+     */
+    PointIndex appendPoints(Span<const double> x, Span<const double> y, Span<const double> z);
+
+    /**
+     * @brief Append points embedded inside a larger array (e.g., the position of the particle structs) to the vtk
+     *        point section's body's file (temp file) without copying the array.
+     * @note The points are not mapped to any cell (see appendCells).
+     * @note The x, y, and z of each point are read contiguously from the begining of each element.
+     * @param points The strided view of the points.
+     * @return The index of the first added point (i.e., the points have consecutive indexes).
+     * @throws If the configuration is locked.
+     */
+    PointIndex appendPoints(StridedSpan<const double> points);
+
+    /**
+     * @brief Append a number of cells of the same type (e.g., a hexahedral grid) to the vtk sections' body's files (temp files).
+     * @note The connectivity is validated once and the cells and their types are written in one batched pass.
+     * @note This will not add points to the point section.
+     * @param type The type of the cells.
+     * @param connectivity The point indexes of the cells, cell after cell.
+     * @param pointsPerCell The number of points of each cell, zero to use the fixed number of points of the type.
+     * @throws If the number of points per cell is not in the acceptable range.
+     * @throws If the connectivity does not hold a whole number of cells.
+     * @throws If the configuration is locked.
+     */
+    void appendCells(const CellType type,
+                     Span<const PointIndex> connectivity,
+                     const Size pointsPerCell = 0);
+
+    /**
+     * @brief Append a mesh of mixed cells (e.g., tetrahedra, pyramids, wedges, and hexahedra) to the vtk sections' body's files (temp files).
+     * @note The mesh is given in the compressed sparse row (CSR) form; the point indexes of the i-th cell are
+     *       connectivity[offsets[i]] to connectivity[offsets[i + 1] - 1].
+     * @note All the cells are validated before appending any of them, then the cells and their types are written in one batched pass.
+     * @note This will not add points to the point section.
+     * @param types The types of the cells.
+     * @param offsets The offsets of the cells inside the connectivity, one more than the cells.
+     * @param connectivity The point indexes of the cells.
+     * @throws If the offsets do not match with the types or the connectivity.
+     * @throws If the number of point indexes of any cell is not in the acceptable range.
+     * @throws If the configuration is locked.
+     */
+    void appendCells(Span<const CellType> types,
+                     Span<const PointIndex> offsets,
+                     Span<const PointIndex> connectivity);
+
     /**
      * @brief Assembles the sections headers and bodies to create the vtk file.
      * @note The vtk file can be assembled any time if the sections are not removed.
      * @param removeTemp If true, removes the temp files of the section bodies afterward.
      * @throws If the size of the sections' content are not compatible.
      */
-    void assemble(bool removeSections = true);
+    virtual void assemble(bool removeSections = true) override;
+
+    /**
+     * @brief Assembles the vtk file on the background io thread (see IOQueue).
+     * @details The sections are handed over to the background assembly (see handOver), so the caller can start
+     *          filling the next file (e.g., the next file of the series) right away.
+     * @note The file is locked afterward; its attribute sections are released (i.e., the references to them should
+     *       not be used anymore) and its temp files belong to the background assembly.
+     * @note The file should not be the shared configuration of other files.
+     * @note Blocks the caller while the maximum number of files are in flight (i.e., backpressure).
+     * @param removeSections If true, removes the temp files of the section bodies afterward.
+     * @return The future that becomes ready once the file is assembled (or holds the exception of the assembly).
+     * @throws If the shared configuration is not locked.
+     * @throws If the file is locked (e.g., already assembled in background).
+     */
+    std::future<void> assembleAsync(bool removeSections = true);
 
     /**
      * @brief Removes the file without move it to bin/trash directory.
@@ -128,38 +389,57 @@ public:
      * @brief Flushes the temp files of sections' bodies but keeps them open!
      * @return True if successful, false otherwise.
      */
-    bool save();
+    virtual bool save() override;
+
+    /**
+     * @brief Sets the encoding of the file.
+     * @throws If the points are streamed straight into the vtk file.
+     * @details In the binary encoding the sections' bodies are stored as raw big-endian numbers
+     *          (i.e., int for the cells and cell types, double for the points) and copied as is to the vtk file.
+     * @note Use this immediately after the constructor, the shared configuration should have the same encoding.
+     * @param encoding The new encoding.
+     * @throws If any of the sections' bodies is not empty.
+     */
+    virtual void setEncoding(const Encoding encoding) override;
 
     /**
      * @brief Sets the data title at the header of the vtk file.
      * @note The title can be up to 150 character, more than that will be cut off.
      * @param title The vtk title.
+     * @throws If the points are streamed straight into the vtk file.
      */
-    void setDataTitle(const std::string & title);
+    virtual void setDataTitle(const std::string & title) override;
+
+    /**
+     * @brief Sets the size of each section's body kept in memory before it is written to its temp file.
+     * @note The sections below the threshold are written to the vtk file straight from the memory on assembly.
+     * @param threshold The number of bytes (zero to write to the temp files right away).
+     */
+    virtual void setSpillThreshold(const Size threshold) override;
 
     /**
      * @brief Set the series initial configuration and export data only on it.
      * @note Any current configuration (cell, point, cell_type sections) will be ignored.
      * @param file The file containg the initial configuration.
+     * @throws If the points are streamed straight into the vtk file.
      */
     void shareConfiguration(const std::shared_ptr<VTKFile> & file);
 
-    /**
-     * @brief Gives read-only access to attribute sections.
-     * @param name The name of the attribute.
-     */
-    const VTKAttributeSection & operator[](const std::string & name) const;
+    using VTKAttributeFile::operator[];
 
     /**
      * @brief Gives direct access to attribute section.
      * @note It will create an attrubute section if not found.
      * @param name The name of the attribute.
+     * @throws If the file is locked.
      */
-    VTKAttributeSection & operator[](const std::string & name);
+    virtual VTKAttributeSection & operator[](const std::string & name) override;
 
 protected:
 
-    using AttributeList = std::map<std::string, std::shared_ptr<VTKAttributeSection> >;
+    friend class VTKHDFFile; // Appends the sections' bodies of the files as its steps.
+    friend class XDMFFile;   // Copies the sections' bodies of the files into its blobs.
+
     using Section = VTKSection;
     using SectionName = VTKSection::Type;
 
@@ -169,11 +449,170 @@ protected:
      */
     void assembleConfiguration(bool lock = false);
 
+    /**
+     * @brief The move constructor, takes over the sections of the other file (see handOver).
+     * @note The other file continues with no attribute sections and new empty configuration sections, while its
+     *       temp files belong to this file.
+     * @param other The file to take the sections over from.
+     */
+    VTKFile(VTKFile && other);
+
+    /**
+     * @brief Creates the file that takes over the sections of this file (e.g., for the background assembly).
+     */
+    virtual std::shared_ptr<VTKFile> handOver();
+
+    /**
+     * @brief Gives the cell section of the configuration (the shared one, if any).
+     */
+    const VTKCellSection & cellSection() const;
+
+    /**
+     * @brief Sets the type the point indexes of the file's own cell section are stored as in the binary encoding.
+     * @param storage The type of the indexes (i.e., Int32 or Int64).
+     * @throws If the storage is neither Int32 nor Int64.
+     * @throws If the cell section's body is not empty.
+     */
+    void setCellIndexStorage(const VTKCellSection::Storage storage);
+
+    /**
+     * @brief Gives the number of cells of the configuration (the shared one, if any), the implicit vertices included.
+     */
+    Size cellCount() const;
+
+    /**
+     * @brief Gives the cell_type section of the configuration (the shared one, if any).
+     */
+    const VTKCellTypeSection & cellTypeSection() const;
+
+    /**
+     * @brief Gives the data title of the configuration (the shared one, if any).
+     */
+    virtual const std::string & dataTitle() const override;
+
+    /**
+     * @brief Gives the point section of the configuration (the shared one, if any).
+     */
+    const VTKPointSection & pointSection() const;
+
+    /**
+     * @brief Flushes the temp files of the configuration (the shared one, if any) and the attribute sections.
+     */
+    void saveSections();
+
+    /**
+     * @brief Gives the header of the vtk file (i.e., the version, title, encoding, and dataset lines).
+     */
+    std::string fileHeader() const;
+
+    /**
+     * @brief Gives the point section header with a fixed-width placeholder for the number of points.
+     */
+    static std::string pointHeaderPlaceholder();
+
+    /**
+     * @brief Writes the number of points over the placeholder of the point section header (see enableDirectWrite).
+     * @throws If the vtk file could not be patched.
+     */
+    void patchPointCount();
+
+    /**
+     * @brief Appends the configuration (i.e., the header, point, cell, and cell_type sections) of this file.
+     * @param target The file to append to.
+     * @param withPoints If false, the header and the point section are assumed to be already in the target (i.e., direct write).
+     * @throws If the content of a section could not be appended.
+     */
+    void appendGeometry(TextFile & target, const bool withPoints) const;
+
+    /**
+     * @brief Gives the assembled configuration of this file, assembling it on the first call.
+     * @note Only valid as long as the configuration is locked, the files sharing it copy the image instead of re-assembling it.
+     * @note The image stays in memory below the spill threshold, otherwise its temp file lives as long as the image.
+     * @throws If the spilled image could not be flushed.
+     */
+    std::shared_ptr<const TextFile> geometryImage();
+
+    /**
+     * @brief Lets go of the assembled configuration image, if any (e.g., when the encoding or title changes).
+     * @note The assemblies using the image meanwhile keep it until they are done.
+     */
+    void discardGeometryImage();
+
+    /**
+     * @brief Appends the cell_type section, expanding the runs of the cell types.
+     * @param target The file to append to.
+     * @param runs The runs of the cell types.
+     */
+    void appendCellTypes(TextFile & target, const VTKCellTypeSection::Runs & runs) const;
+
+    /**
+     * @brief Appends generated values exactly as the cell or cell_type sections' bodies would hold them.
+     * @param target The file to append to.
+     * @param values The values.
+     * @param count The number of the values.
+     * @param rowSize The number of the values of each row (i.e., of each line in the ascii encoding).
+     * @param format The number format of the section.
+     */
+    void appendGeneratedRows(TextFile & target, const unsigned long * values, const Size count, const Size rowSize,
+                             const NumberFormat & format) const;
+
+    /**
+     * @brief Appends the cell section of the point cloud, generating the implicit vertices.
+     * @param target The file to append to.
+     * @param count The number of the vertices (i.e., the number of the points).
+     */
+    void appendImplicitCells(TextFile & target, const Size count) const;
+
+    /**
+     * @brief Checks whether the file still owns its sections or not (see handOver).
+     * @throws If the sections are handed over.
+     */
+    void checkSectionsOwned() const;
+
+    /**
+     * @brief Checks whether the cells can be appended explicitly (i.e., the file is not a point cloud) or not.
+     * @throws If the file is a point cloud.
+     */
+    void checkExplicitCells() const;
+
+    /**
+     * @brief Checks whether a cell can be an implicit vertex of the point cloud or not.
+     * @param type The type of the cell.
+     * @param points The number of the points of the cell.
+     * @throws If the cell is not a single vertex.
+     */
+    static void checkImplicitVertex(const CellType type, const Size points);
+
+    /**
+     * @brief Checks whether the cells of a shard can be merged into the file or not, before anything is appended.
+     * @param shard The shard.
+     * @throws If a cell refers to a point out of the shard or its number of points does not fit its type.
+     * @throws If the file is a point cloud and a cell is not a single vertex.
+     */
+    void checkShardCells(const VTKShard & shard) const;
+
+    /**
+     * @brief Appends a point to the point section unless it is welded to an already appended point.
+     * @param x The x of the point.
+     * @param y The y of the point.
+     * @param z The z of the point.
+     * @return The index of the point.
+     */
+    PointIndex appendWeldedPoint(const double x, const double y, const double z);
+
+    /**
+     * @brief Appends the points of a shard (welded, if the welding is enabled) to the file or its configuration.
+     * @param xyz The dimension of the points in sereis (i.g., x_0, y_0, z_0, x_1, y_1, ...).
+     * @param pointsMap Is filled by the index of each point of the shard.
+     * @throws If the configuration is locked.
+     */
+    void appendShardPoints(Span<const double> xyz, std::vector<PointIndex> & pointsMap);
+
     /**
      * @brief Removes the temperory files related to this vtk (i.e., The section's bodies)
      * @return True if successful, false otherwise.
      */
-    bool removeTemperoryFiles();
+    virtual bool removeTemperoryFiles() override;
 
     /**
      * @brief Computes whether the section's bodies have a compatible sizes or not.
@@ -182,13 +621,18 @@ protected:
 
 private:
 
-    AttributeList p_attributeSections;
     VTKCellSection p_cellSection;
     VTKCellTypeSection p_cellTypeSection;
     std::shared_ptr<VTKFile> p_configuration;
-    std::string p_dataTitle; // <= The data title, at the header of the vtk file.
+    bool p_directWrite;         // Whether the points are streamed straight into the vtk file.
+    Size p_pointCountOffset;    // The offset of the placeholder of the number of points, if streaming.
+    bool p_handedOver;          // Whether the sections are taken over by another file (see handOver).
     bool p_locked;
+    bool p_pointCloud;          // Whether the cells are the implicit vertices of the points.
     VTKPointSection p_pointSection;
+    std::vector<std::shared_ptr<VTKShard> > p_shards;  // The shards of the threads, if any.
+    std::shared_ptr<VTKPointWelder> p_welder;   // The welder of the points, if welding.
+    std::shared_ptr<const TextFile> p_geometryImage;    // The assembled configuration, once shared and locked.
 
 };
 
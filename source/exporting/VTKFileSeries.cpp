@@ -16,6 +16,8 @@ VTKFileSeries::VTKFileSeries(const std::string &basename,
                              const bool override,
                              const bool fillVocations)
     : file_system::FileSeries<VTKFile>(basename, extension, allowedSize, override, fillVocations)
+    , p_collection{std::make_shared<PVDFile>(directory() + FileSeries::basename(), override)}
+    , p_encoding{VTKFile::Encoding::Ascii}
     , p_isSharedConfigIsInteranl{false}
     , p_sharedConfiguration{}
 {
@@ -37,6 +39,18 @@ VTKFileSeries::~VTKFileSeries()
         p_sharedConfiguration->remove();
 }
 
+void VTKFileSeries::appendToCollection(const Index index, const double time)
+{
+    if (!isCreated(index) && !wasExisted(index))
+        throw std::out_of_range("The file at index " + std::to_string(index) + " is neither created nor existed.");
+    p_collection->appendDataSet(time, fullName(index, false));
+}
+
+const PVDFile &VTKFileSeries::collection() const
+{
+    return *p_collection;
+}
+
 bool VTKFileSeries::isShareingConfiguration() const
 {
     return static_cast<bool>(p_sharedConfiguration);
@@ -53,28 +67,32 @@ void VTKFileSeries::lockSharedConfiguration() const
 
 VTKFile &VTKFileSeries::at(const Index index)
 {
-    if(p_sharedConfiguration) {
-        const auto file = std::make_shared<VTKFile>(FileSeries::at(index));
-        file->shareConfiguration(p_sharedConfiguration);
-        return *file;
-    }
-    return FileSeries::at(index);
+    auto & file = prepare(FileSeries::at(index));
+    if (p_sharedConfiguration && !file.isSharingConfiguration())
+        file.shareConfiguration(p_sharedConfiguration);
+    return file;
 }
 
 VTKFile &VTKFileSeries::next()
 {
-    if(p_sharedConfiguration) {
-        const auto file = std::make_shared<VTKFile>(FileSeries::next());
-        file->shareConfiguration(p_sharedConfiguration);
-        return *file;
-    }
-    return FileSeries::next();
+    auto & file = prepare(FileSeries::next());
+    if (p_sharedConfiguration && !file.isSharingConfiguration())
+        file.shareConfiguration(p_sharedConfiguration);
+    return file;
+}
+
+void VTKFileSeries::setEncoding(const VTKFile::Encoding encoding)
+{
+    p_encoding = encoding;
+    if (p_sharedConfiguration && p_isSharedConfigIsInteranl)
+        p_sharedConfiguration->setEncoding(encoding);
 }
 
 void VTKFileSeries::shareConfiguration()
 {
     p_isSharedConfigIsInteranl = true;
     p_sharedConfiguration = std::make_shared<VTKFile>(name(0,true) + "_shared_configuration", extension());
+    p_sharedConfiguration->setEncoding(p_encoding);
 }
 
 void VTKFileSeries::shareConfiguration(const std::shared_ptr<VTKFile> file)
@@ -83,6 +101,11 @@ void VTKFileSeries::shareConfiguration(const std::shared_ptr<VTKFile> file)
     p_sharedConfiguration = file;
 }
 
-
+VTKFile &VTKFileSeries::prepare(VTKFile &file)
+{
+    if (file.encoding() != p_encoding)
+        file.setEncoding(p_encoding);
+    return file;
+}
 
 } // namespace exporting
@@ -9,6 +9,7 @@
 #ifndef VTKFILESERIES_H
 #define VTKFILESERIES_H
 
+#include "PVDFile.h"
 #include "VTKFile.h"
 #include "file_system/FileSeries.h"
 
@@ -59,6 +60,22 @@ public:
      */
     ~VTKFileSeries();
 
+    /**
+     * @brief Appends a file of the series to the ParaView collection of the series (i.e., <basename>.pvd) at a simulation time.
+     * @note Should be called once the file is assembled, so the collection can be followed while the simulation is running.
+     * @note The collection is started over by the first call if the series overrides the existing files (see the constructor).
+     * @param index The index of the file.
+     * @param time The simulation time of the file.
+     * @throws If the file at the index is neither created nor existed.
+     * @throws If the collection could not be written.
+     */
+    void appendToCollection(const Index index, const double time);
+
+    /**
+     * @brief Gives the ParaView collection of the series (i.e., <basename>.pvd).
+     */
+    const PVDFile & collection() const;
+
     /**
      * @brief Whether the file series are exporting data on a sheared configuration or not.
      * @note If true, then adding a cell to one file will be added to all future files.
@@ -67,6 +84,7 @@ public:
 
     /**
      * @brief Locks the shared configuration from appending new ponts/cells to it.
+     * @note Once locked, the configuration is assembled once and each file of the series only copies it before its attributes.
      */
     void lockSharedConfiguration() const;
 
@@ -85,6 +103,12 @@ public:
      */
     VTKFile & next();
 
+    /**
+     * @brief Sets the encoding of the future files (and the shared configuration, if any).
+     * @param encoding The new encoding.
+     */
+    void setEncoding(const VTKFile::Encoding encoding);
+
     /**
      * @brief Shares the future files configurations.
      */
@@ -99,6 +123,15 @@ public:
 
 private:
 
+    /**
+     * @brief Prepares a file of the series (i.e., sets the encoding of the series to it).
+     * @param file The file.
+     * @return The file.
+     */
+    VTKFile & prepare(VTKFile & file);
+
+    std::shared_ptr<PVDFile> p_collection;
+    VTKFile::Encoding p_encoding;
     bool p_isSharedConfigIsInteranl;
     std::shared_ptr<VTKFile> p_sharedConfiguration;
 
@@ -0,0 +1,381 @@
+//
+//  VTKHDFFile.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifdef EXPORTING_WITH_HDF5
+
+#include "VTKHDFFile.h"
+
+namespace exporting {
+
+namespace {
+
+constexpr std::size_t blockRows = 1 << 13; // The number of rows read from a section's body at once.
+
+/**
+ * @brief The Handle class closes an HDF5 object once it goes out of scope.
+ */
+class Handle
+{
+public:
+
+    /**
+     * @brief The constructor.
+     * @param id The HDF5 object.
+     * @param close The function closing the object (e.g., H5Dclose).
+     * @param what What was done to get the object, for the error message.
+     * @throws If the object is invalid (i.e., negative).
+     */
+    Handle(const hid_t id, herr_t (*close)(hid_t), const std::string & what)
+        : p_id{id}
+        , p_close{close}
+    {
+        if (id < 0)
+            throw std::runtime_error("Could not " + what + " of the vtkhdf file.");
+    }
+
+    Handle(const Handle& other) = delete;
+    Handle& operator =(const Handle&) = delete;
+
+    ~Handle() {
+        p_close(p_id);
+    }
+
+    operator hid_t() const {
+        return p_id;
+    }
+
+private:
+
+    hid_t p_id;                 // The HDF5 object.
+    herr_t (*p_close)(hid_t);   // The function closing the object.
+
+};
+
+/**
+ * @brief Throws if an HDF5 call failed.
+ * @param status The status of the call.
+ * @param what What the call does, for the error message.
+ */
+void check(const herr_t status, const std::string & what) {
+    if (status < 0)
+        throw std::runtime_error("Could not " + what + " of the vtkhdf file.");
+}
+
+/**
+ * @brief Creates an extendible chunked dataset with no rows.
+ * @param location The group of the dataset.
+ * @param name The name of the dataset.
+ * @param type The HDF5 type of the values on the file.
+ * @param columns The number of the values of each row, a one-dimensional dataset if zero.
+ */
+void createDataset(const hid_t location, const std::string & name, const hid_t type, const hsize_t columns = 0) {
+    const int rank = (columns) ? 2 : 1;
+    const hsize_t dims[2] = {0, columns};
+    const hsize_t maxDims[2] = {H5S_UNLIMITED, columns};
+    const hsize_t chunk[2] = {VTKHDFFile::chunkSize, columns};
+    Handle space{H5Screate_simple(rank, dims, maxDims), H5Sclose, "create the space of " + name};
+    Handle properties{H5Pcreate(H5P_DATASET_CREATE), H5Pclose, "create the properties of " + name};
+    check(H5Pset_chunk(properties, rank, chunk), "chunk " + name);
+    Handle dataset{H5Dcreate2(location, name.c_str(), type, space, H5P_DEFAULT, properties, H5P_DEFAULT),
+                H5Dclose, "create " + name};
+}
+
+/**
+ * @brief Appends rows to a dataset.
+ * @param location The group of the dataset.
+ * @param name The name of the dataset.
+ * @param type The HDF5 type of the values in the memory.
+ * @param values The values of the rows.
+ * @param rows The number of the rows.
+ * @return The number of the rows before the appended ones (i.e., the offset of the appended rows).
+ */
+hsize_t appendRows(const hid_t location, const std::string & name, const hid_t type, const void * values, const hsize_t rows) {
+    Handle dataset{H5Dopen2(location, name.c_str(), H5P_DEFAULT), H5Dclose, "open " + name};
+    hsize_t dims[2] = {0, 0};
+    {
+        Handle space{H5Dget_space(dataset), H5Sclose, "get the space of " + name};
+        H5Sget_simple_extent_dims(space, dims, nullptr);
+    }
+    const auto ans = dims[0];
+    if (!rows)
+        return ans;
+    const int rank = (dims[1]) ? 2 : 1;
+    const hsize_t start[2] = {ans, 0};
+    const hsize_t count[2] = {rows, dims[1]};
+    dims[0] += rows;
+    check(H5Dset_extent(dataset, dims), "extend " + name);
+    Handle fileSpace{H5Dget_space(dataset), H5Sclose, "get the space of " + name};
+    check(H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, start, nullptr, count, nullptr), "select the rows of " + name);
+    Handle memorySpace{H5Screate_simple(rank, count, nullptr), H5Sclose, "create the rows of " + name};
+    check(H5Dwrite(dataset, type, memorySpace, fileSpace, H5P_DEFAULT, values), "write " + name);
+    return ans;
+}
+
+/**
+ * @brief Appends one value to a one-dimensional dataset.
+ * @return The offset of the value.
+ */
+hsize_t appendValue(const hid_t location, const std::string & name, const std::int64_t value) {
+    return appendRows(location, name, H5T_NATIVE_INT64, &value, 1);
+}
+
+/**
+ * @brief Reads the content of a section's body in blocks of whole rows.
+ * @note The spilled part of the body is read from its temp file and the rest from its memory.
+ * @param body The section's body.
+ * @param rowBytes The number of bytes of each row.
+ * @param visit The function that receives each block (i.e., the pointer to the bytes and the number of rows).
+ * @throws If the temp file of the section's body could not be opened.
+ */
+template<typename Visitor>
+void readRowBlocks(const VTKSection::Body & body, const std::size_t rowBytes, Visitor visit) {
+    const auto read = body.readContent(blockRows * rowBytes, [&visit, rowBytes](const char * bytes, const std::size_t size) {
+        visit(bytes, size / rowBytes);
+    });
+    if (!read)
+        throw std::runtime_error("Could not open the section's body (" + body.fullName(true) + ").");
+}
+
+} // namespace
+
+VTKHDFFile::VTKHDFFile(const std::string &name, const std::string &extension)
+    : file_system::BaseFile{name, extension}
+    , p_file{-1}
+    , p_attributes{}
+    , p_geometrySource{}
+    , p_partOffset{0}
+    , p_pointOffset{0}
+    , p_cellOffset{0}
+    , p_connectivityOffset{0}
+    , p_stepCount{0}
+{
+}
+
+VTKHDFFile::VTKHDFFile(const std::string &path, const std::string &name, const std::string &extension)
+    : VTKHDFFile{path + name, extension}
+{
+}
+
+VTKHDFFile::~VTKHDFFile() {
+    if (p_file >= 0)
+        H5Fclose(p_file);
+}
+
+VTKHDFFile::Size VTKHDFFile::stepCount() const {
+    return p_stepCount;
+}
+
+void VTKHDFFile::appendStep(VTKFile &file, const double time, bool removeSections) {
+    file.mergeShards();
+    if (file.encoding() != VTKFile::Encoding::Binary || file.pointSection().encoding() != VTKFile::Encoding::Binary)
+        throw std::runtime_error("The vtk file of the step should be in the binary encoding.");
+    if (file.isDirectWrite())
+        throw std::logic_error("The points of the vtk file of the step should not be written directly.");
+    if (!file.sectionBodySizesMatch())
+        throw std::runtime_error("The size of the sections' content are not compatible..");
+    file.saveSections(); // Flush the tempfiles.
+
+    if (p_file < 0)
+        create(file);
+    std::map<std::string, Source> attributes;
+    for (const auto & attributeSection : file.attributeSections())
+        attributes.emplace(attributeSection.first, attributeSection.second->source());
+    if (attributes != p_attributes)
+        throw std::runtime_error("The attributes of the step are not the same as the ones of the first step.");
+
+    Handle root{H5Gopen2(p_file, "VTKHDF", H5P_DEFAULT), H5Gclose, "open the root group"};
+    Handle steps{H5Gopen2(root, "Steps", H5P_DEFAULT), H5Gclose, "open the Steps group"};
+
+    // The geometry of a locked shared configuration is written once.
+    const auto & configuration = file.p_configuration;
+    const bool shared = configuration && configuration->isLocked();
+    if (!shared || configuration != p_geometrySource) {
+        appendGeometry(file);
+        p_geometrySource = (shared) ? configuration : nullptr;
+    }
+
+    // The attributes
+    for (const auto source : {Source::Point, Source::Cell}) {
+        const std::string group = (source == Source::Point) ? "PointData" : "CellData";
+        Handle data{H5Gopen2(root, group.c_str(), H5P_DEFAULT), H5Gclose, "open the " + group + " group"};
+        Handle offsets{H5Gopen2(steps, (group + "Offsets").c_str(), H5P_DEFAULT), H5Gclose, "open the " + group + "Offsets group"};
+        for (const auto & attributeSection : file.attributeSections()) {
+            const auto & section = *attributeSection.second;
+            if (section.source() != source)
+                continue;
+            const auto & name = section.attributeName();
+            const auto type = to_hdf5(section.format().storage());
+            const auto rowBytes = section.componentCount() * NumberFormat::sizeOf(section.format().storage());
+            hsize_t offset = appendRows(data, name, type, nullptr, 0);
+            readRowBlocks(section.body(), rowBytes, [&](const char * bytes, const std::size_t rows) {
+                appendRows(data, name, type, bytes, rows);
+            });
+            appendValue(offsets, name, static_cast<std::int64_t>(offset));
+        }
+    }
+
+    // The step
+    const auto stepOffset = appendRows(steps, "Values", H5T_NATIVE_DOUBLE, &time, 1);
+    appendValue(steps, "PartOffsets", p_partOffset);
+    appendValue(steps, "NumberOfParts", 1);
+    appendValue(steps, "PointOffsets", p_pointOffset);
+    appendValue(steps, "CellOffsets", p_cellOffset);
+    appendValue(steps, "ConnectivityIdOffsets", p_connectivityOffset);
+    p_stepCount = stepOffset + 1;
+    const std::int64_t stepCount = p_stepCount;
+    Handle count{H5Aopen(steps, "NSteps", H5P_DEFAULT), H5Aclose, "open the NSteps attribute"};
+    check(H5Awrite(count, H5T_NATIVE_INT64, &stepCount), "write the NSteps attribute");
+    check(H5Fflush(p_file, H5F_SCOPE_LOCAL), "flush");
+
+    if (removeSections)
+        if (!file.removeTemperoryFiles())
+            throw std::runtime_error("Could not remove the temp files (sections' bodies).");
+}
+
+void VTKHDFFile::create(const VTKFile &file) {
+    const auto path = fullName(true);
+    p_file = H5Fcreate(path.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    if (p_file < 0)
+        throw std::runtime_error("Could not create the vtkhdf file (" + path + ").");
+
+    Handle root{H5Gcreate2(p_file, "VTKHDF", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT), H5Gclose, "create the root group"};
+    {
+        const int version[2] = {2, 0};
+        const hsize_t size = 2;
+        Handle space{H5Screate_simple(1, &size, nullptr), H5Sclose, "create the space of the Version attribute"};
+        Handle attribute{H5Acreate2(root, "Version", H5T_STD_I32LE, space, H5P_DEFAULT, H5P_DEFAULT),
+                    H5Aclose, "create the Version attribute"};
+        check(H5Awrite(attribute, H5T_NATIVE_INT, version), "write the Version attribute");
+    }
+    {
+        const std::string name = "UnstructuredGrid";
+        Handle type{H5Tcopy(H5T_C_S1), H5Tclose, "create the type of the Type attribute"};
+        check(H5Tset_size(type, name.size()), "size the Type attribute");
+        check(H5Tset_strpad(type, H5T_STR_NULLPAD), "pad the Type attribute");
+        check(H5Tset_cset(type, H5T_CSET_ASCII), "encode the Type attribute");
+        Handle space{H5Screate(H5S_SCALAR), H5Sclose, "create the space of the Type attribute"};
+        Handle attribute{H5Acreate2(root, "Type", type, space, H5P_DEFAULT, H5P_DEFAULT), H5Aclose, "create the Type attribute"};
+        check(H5Awrite(attribute, type, name.data()), "write the Type attribute");
+    }
+
+    for (const auto name : {"NumberOfPoints", "NumberOfCells", "NumberOfConnectivityIds", "Offsets", "Connectivity"})
+        createDataset(root, name, H5T_STD_I64LE);
+    createDataset(root, "Points", H5T_IEEE_F64BE, 3);
+    createDataset(root, "Types", H5T_STD_U8LE);
+
+    Handle steps{H5Gcreate2(root, "Steps", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT), H5Gclose, "create the Steps group"};
+    {
+        const std::int64_t none = 0;
+        Handle space{H5Screate(H5S_SCALAR), H5Sclose, "create the space of the NSteps attribute"};
+        Handle attribute{H5Acreate2(steps, "NSteps", H5T_STD_I64LE, space, H5P_DEFAULT, H5P_DEFAULT),
+                    H5Aclose, "create the NSteps attribute"};
+        check(H5Awrite(attribute, H5T_NATIVE_INT64, &none), "write the NSteps attribute");
+    }
+    createDataset(steps, "Values", H5T_IEEE_F64LE);
+    for (const auto name : {"PartOffsets", "NumberOfParts", "PointOffsets"})
+        createDataset(steps, name, H5T_STD_I64LE);
+    for (const auto name : {"CellOffsets", "ConnectivityIdOffsets"})
+        createDataset(steps, name, H5T_STD_I64LE, 1); // One column per cell topology.
+
+    for (const auto source : {Source::Point, Source::Cell}) {
+        const std::string group = (source == Source::Point) ? "PointData" : "CellData";
+        Handle data{H5Gcreate2(root, group.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT), H5Gclose, "create the " + group + " group"};
+        Handle offsets{H5Gcreate2(steps, (group + "Offsets").c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT),
+                    H5Gclose, "create the " + group + "Offsets group"};
+        for (const auto & attributeSection : file.attributeSections()) {
+            const auto & section = *attributeSection.second;
+            if (section.source() != source)
+                continue;
+            const auto components = section.componentCount();
+            createDataset(data, section.attributeName(), to_hdf5(section.format().storage()), (components > 1) ? components : 0);
+            createDataset(offsets, section.attributeName(), H5T_STD_I64LE);
+            p_attributes.emplace(attributeSection.first, section.source());
+        }
+    }
+}
+
+void VTKHDFFile::appendGeometry(const VTKFile &file) {
+    Handle root{H5Gopen2(p_file, "VTKHDF", H5P_DEFAULT), H5Gclose, "open the root group"};
+    const auto & points = file.pointSection();
+    const std::int64_t pointCount = points.pointCount();
+    const std::int64_t cellCount = file.cellCount();
+    const std::int64_t connectivityCount = (file.isPointCloud()) ? pointCount : file.cellSection().pointCount();
+
+    p_partOffset = appendValue(root, "NumberOfPoints", pointCount);
+    appendValue(root, "NumberOfCells", cellCount);
+    appendValue(root, "NumberOfConnectivityIds", connectivityCount);
+
+    // The points are kept as the big-endian doubles of the binary section.
+    p_pointOffset = appendRows(root, "Points", H5T_IEEE_F64BE, nullptr, 0);
+    readRowBlocks(points.body(), 3 * sizeof(double), [&root](const char * bytes, const std::size_t rows) {
+        appendRows(root, "Points", H5T_IEEE_F64BE, bytes, rows);
+    });
+
+    // Each part has its own offsets, starting from zero (i.e., one more than its cells).
+    p_cellOffset = appendRows(root, "Types", H5T_NATIVE_ULONG, nullptr, 0);
+    p_connectivityOffset = appendRows(root, "Connectivity", H5T_NATIVE_INT64, nullptr, 0);
+    std::vector<std::int64_t> offsets{0};
+    std::vector<std::int64_t> connectivity;
+    offsets.reserve(blockRows);
+    connectivity.reserve(blockRows);
+    const auto flush = [&root, &offsets, &connectivity]() {
+        appendRows(root, "Offsets", H5T_NATIVE_INT64, offsets.data(), offsets.size());
+        appendRows(root, "Connectivity", H5T_NATIVE_INT64, connectivity.data(), connectivity.size());
+        offsets.clear();
+        connectivity.clear();
+    };
+    if (file.isPointCloud()) {
+        // The implicit vertices: the connectivity is 0, 1, 2, ... and the offsets are 1, 2, 3, ...
+        for (std::int64_t i = 0; i < pointCount; i++) {
+            connectivity.emplace_back(i);
+            offsets.emplace_back(i + 1);
+            if (connectivity.size() == blockRows)
+                flush();
+        }
+    } else {
+        // The cell section holds the point count of each cell followed by its point indexes.
+        std::int64_t remainingPoints = 0;
+        std::int64_t end = 0;
+        file.cellSection().readBinary([&](const std::int64_t * values, const std::size_t count) {
+            for (std::size_t i = 0; i < count; i++) {
+                if (remainingPoints == 0) {
+                    remainingPoints = values[i];
+                    end += values[i];
+                    offsets.emplace_back(end);
+                } else {
+                    remainingPoints--;
+                    connectivity.emplace_back(values[i]);
+                }
+            }
+            flush();
+        });
+    }
+    flush();
+
+    const auto & runs = (file.isPointCloud()) ? VTKCellTypeSection::Runs{{VTKCell::Type::Vertex, points.pointCount()}}
+                                              : file.cellTypeSection().runs();
+    VTKCellTypeSection::expand(runs, [&root](const VTKCell::Code * codes, const VTKCellTypeSection::Size size) {
+        appendRows(root, "Types", H5T_NATIVE_ULONG, codes, size);
+    });
+}
+
+hid_t VTKHDFFile::to_hdf5(const VTKHDFFile::Storage storage) {
+    switch (storage) {
+    case Storage::UInt8:    return H5T_STD_U8BE;
+    case Storage::Int32:    return H5T_STD_I32BE;
+    case Storage::Int64:    return H5T_STD_I64BE;
+    case Storage::UInt64:   return H5T_STD_U64BE;
+    case Storage::Float32:  return H5T_IEEE_F32BE;
+    case Storage::Float64:  return H5T_IEEE_F64BE;
+    }
+    throw std::range_error("The storage type is out of known range.");
+}
+
+} // namespace exporting
+
+#endif // EXPORTING_WITH_HDF5
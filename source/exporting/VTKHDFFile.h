@@ -0,0 +1,129 @@
+//
+//  VTKHDFFile.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef VTKHDFFILE_H
+#define VTKHDFFILE_H
+
+#ifdef EXPORTING_WITH_HDF5
+
+#include "VTKFile.h"
+#include <hdf5.h>
+#include <map>
+#include <memory>
+
+/**
+ * The exporting namespace provides the means to handle exporting simulation data to files.
+ */
+namespace exporting {
+
+/**
+ * @brief The VTKHDFFile class provides the means to handle exporting the steps of a simulation to one VTKHDF (.vtkhdf)
+ *        file, i.e., an HDF5 file holding an UnstructuredGrid and its Steps group.
+ * @details Each step is a VTKFile (e.g., the files given by VTKFileSeries::next) whose sections' bodies are appended to
+ *          the chunked datasets of the file (see appendStep), so a run produces one file instead of a file per step.
+ *          The geometry of the steps sharing the same locked configuration (see VTKFileSeries::lockSharedConfiguration)
+ *          is written once, the later steps only refer to it.
+ * @note Only available if the library is built with EXPORTING_WITH_HDF5 (and linked to libhdf5).
+ * @note The class is not default constructable.
+ * @note The class is not copiable.
+ */
+class VTKHDFFile: public file_system::BaseFile
+{
+public:
+
+    using Size = std::size_t;
+
+    static constexpr hsize_t chunkSize = 1 << 12; // The number of rows of each chunk of the datasets.
+
+    /**
+     * @brief The constructor.
+     * @note The file is created (overriding any existing one) by the first step.
+     * @param name The name of the file (the path to the file included).
+     * @param extension The extention of the file without the dot(.).
+     */
+    explicit VTKHDFFile(const std::string &name,
+                        const std::string &extension = "vtkhdf");
+
+    /**
+     * @brief The constructor.
+     * @note The file is created (overriding any existing one) by the first step.
+     * @param path The directory path of the file.
+     * @param name The name of the file.
+     * @param extension The extention of the file without the dot(.).
+     */
+    explicit VTKHDFFile(const std::string &path,
+                        const std::string &name,
+                        const std::string &extension);
+
+    VTKHDFFile(const VTKHDFFile& other) = delete;
+    VTKHDFFile& operator =(const VTKHDFFile&) = delete;
+
+    /**
+     * @brief The deconstructor, closes the file.
+     */
+    ~VTKHDFFile();
+
+    /**
+     * @brief Gives the number of the steps appended so far.
+     */
+    Size stepCount() const;
+
+    /**
+     * @brief Appends the content of a vtk file as the next step.
+     * @note The file is flushed afterward, so the steps appended so far survive a crash of the simulation.
+     * @param file The vtk file of the step, in the binary encoding.
+     * @param time The simulation time of the step.
+     * @param removeSections If true, removes the temp files of the vtk file's section bodies afterward.
+     * @throws If the vtk file is not in the binary encoding or writes the points directly.
+     * @throws If the size of the sections' content are not compatible.
+     * @throws If the attributes are not the same as the ones of the first step.
+     * @throws If the file could not be written.
+     */
+    void appendStep(VTKFile & file, const double time, bool removeSections = true);
+
+private:
+
+    using Source = VTKAttributeSection::SourceType;
+    using Storage = NumberFormat::Storage;
+
+    /**
+     * @brief Creates the file, its groups, and the datasets of the steps.
+     * @param file The vtk file of the first step (i.e., the attributes of all of the steps).
+     * @throws If the file could not be created.
+     */
+    void create(const VTKFile & file);
+
+    /**
+     * @brief Appends the points and cells of a vtk file as a new part.
+     * @param file The vtk file.
+     * @throws If the datasets could not be written.
+     */
+    void appendGeometry(const VTKFile & file);
+
+    /**
+     * @brief Gives the HDF5 type of a storage type, in big-endian (i.e., the byte order of the binary sections).
+     * @param storage The storage type.
+     */
+    static hid_t to_hdf5(const Storage storage);
+
+    hid_t p_file;                                       // The HDF5 file, negative until the first step.
+    std::map<std::string, Source> p_attributes;         // The attributes of the steps.
+    std::shared_ptr<VTKFile> p_geometrySource;          // The locked configuration of the last written geometry, if any.
+    hsize_t p_partOffset;                               // The index of the last written part.
+    hsize_t p_pointOffset;                              // The offset of the points of the last written part.
+    hsize_t p_cellOffset;                               // The offset of the cells of the last written part.
+    hsize_t p_connectivityOffset;                       // The offset of the connectivity of the last written part.
+    Size p_stepCount;                                   // The number of the steps appended so far.
+
+};
+
+} // namespace exporting
+
+#endif // EXPORTING_WITH_HDF5
+
+#endif // VTKHDFFILE_H
@@ -0,0 +1,52 @@
+//
+//  VTKRectilinearGridFile.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "VTKRectilinearGridFile.h"
+#include <stdexcept>
+
+namespace exporting {
+
+VTKRectilinearGridFile::VTKRectilinearGridFile(const std::string &name,
+                                               const VTKRectilinearGridFile::Coordinates &x,
+                                               const VTKRectilinearGridFile::Coordinates &y,
+                                               const VTKRectilinearGridFile::Coordinates &z,
+                                               const std::string &extension)
+    : VTKStructuredFile{name, {x.size(), y.size(), z.size()}, extension}
+    , p_coordinates{x, y, z}
+{
+}
+
+VTKRectilinearGridFile::VTKRectilinearGridFile(const std::string &path,
+                                               const std::string &name,
+                                               const VTKRectilinearGridFile::Coordinates &x,
+                                               const VTKRectilinearGridFile::Coordinates &y,
+                                               const VTKRectilinearGridFile::Coordinates &z,
+                                               const std::string &extension)
+    : VTKRectilinearGridFile{path + name, x, y, z, extension}
+{
+}
+
+const VTKRectilinearGridFile::Coordinates &VTKRectilinearGridFile::coordinates(const VTKRectilinearGridFile::Size axis) const {
+    return p_coordinates.at(axis);
+}
+
+std::string VTKRectilinearGridFile::dataset() const {
+    return "RECTILINEAR_GRID";
+}
+
+void VTKRectilinearGridFile::appendGeometry() {
+    const char * axes[] = {"X", "Y", "Z"};
+    for (Size i = 0; i < p_coordinates.size(); i++) {
+        const auto & coordinates = p_coordinates[i];
+        if (TextFile::append(std::string(axes[i]) + "_COORDINATES " + std::to_string(coordinates.size()) + " double\n") <= 0
+                || !appendNumbers(coordinates.data(), coordinates.size()))
+            throw std::runtime_error("Could not append the " + std::string(axes[i]) + " coordinates of the rectilinear grid.");
+    }
+}
+
+} // namespace exporting
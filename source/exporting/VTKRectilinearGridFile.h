@@ -0,0 +1,86 @@
+//
+//  VTKRectilinearGridFile.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef VTKRECTILINEARGRIDFILE_H
+#define VTKRECTILINEARGRIDFILE_H
+
+#include "VTKStructuredFile.h"
+#include <vector>
+
+/**
+ * The exporting namespace provides the means to handle exporting simulation data to files.
+ */
+namespace exporting {
+
+/**
+ * @brief The VTKRectilinearGridFile class provides the means to handle exporting data on a grid with varying spacing
+ *        along its axes (i.e., a RECTILINEAR_GRID dataset) to a legacy vtk file.
+ * @details The points are given by their coordinates along the x, y, and z; the dimensions of the grid are the
+ *          number of the coordinates.
+ * @note The class is not default constructable.
+ */
+class VTKRectilinearGridFile: public VTKStructuredFile
+{
+public:
+
+    using Coordinates = std::vector<double>;
+
+    /**
+     * @brief The constructor.
+     * @param name The name of the file (the path to the file included).
+     * @param x The coordinates of the points along the x.
+     * @param y The coordinates of the points along the y.
+     * @param z The coordinates of the points along the z.
+     * @param extension The extention of the file without the dot(.).
+     * @throws If any of the coordinates is empty.
+     */
+    explicit VTKRectilinearGridFile(const std::string &name,
+                                    const Coordinates &x,
+                                    const Coordinates &y,
+                                    const Coordinates &z,
+                                    const std::string &extension = "vtk");
+
+    /**
+     * @brief The constructor.
+     * @param path The directory path of the file.
+     * @param name The name of the file.
+     * @param x The coordinates of the points along the x.
+     * @param y The coordinates of the points along the y.
+     * @param z The coordinates of the points along the z.
+     * @param extension The extention of the file without the dot(.).
+     * @throws If any of the coordinates is empty.
+     */
+    explicit VTKRectilinearGridFile(const std::string &path,
+                                    const std::string &name,
+                                    const Coordinates &x,
+                                    const Coordinates &y,
+                                    const Coordinates &z,
+                                    const std::string &extension);
+
+    /**
+     * @brief Gives the coordinates of the points along an axis.
+     * @param axis The axis (i.e., 0 for the x, 1 for the y, and 2 for the z).
+     * @throws If the axis is out of range.
+     */
+    const Coordinates & coordinates(const Size axis) const;
+
+protected:
+
+    virtual std::string dataset() const override;
+
+    virtual void appendGeometry() override;
+
+private:
+
+    std::array<Coordinates, 3> p_coordinates;   // The coordinates of the points along the x, y, and z.
+
+};
+
+} // namespace exporting
+
+#endif // VTKRECTILINEARGRIDFILE_H
@@ -0,0 +1,111 @@
+//
+//  VTKStructuredFile.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "VTKStructuredFile.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace exporting {
+
+namespace {
+
+constexpr VTKStructuredFile::Size numbersPerLine = 9; // The number of the ascii numbers of each line (i.e., three points).
+
+} // namespace
+
+VTKStructuredFile::VTKStructuredFile(const std::string &name,
+                                     const VTKStructuredFile::Dimensions &dimensions,
+                                     const std::string &extension)
+    : VTKAttributeFile{name, extension}
+    , p_dimensions{dimensions}
+{
+    for (const auto dimension : p_dimensions)
+        if (!dimension)
+            throw std::range_error("The structured grid should have at least one point along each dimension.");
+}
+
+VTKStructuredFile::VTKStructuredFile(const std::string &path,
+                                     const std::string &name,
+                                     const VTKStructuredFile::Dimensions &dimensions,
+                                     const std::string &extension)
+    : VTKStructuredFile{path + name, dimensions, extension}
+{
+}
+
+const VTKStructuredFile::Dimensions &VTKStructuredFile::dimensions() const {
+    return p_dimensions;
+}
+
+VTKStructuredFile::Size VTKStructuredFile::pointCount() const {
+    return p_dimensions[0] * p_dimensions[1] * p_dimensions[2];
+}
+
+VTKStructuredFile::Size VTKStructuredFile::cellCount() const {
+    Size ans = 1;
+    for (const auto dimension : p_dimensions)
+        ans *= (dimension > 1) ? dimension - 1 : 1;
+    return ans;
+}
+
+void VTKStructuredFile::assemble(bool removeSections) {
+    if (!sectionBodySizesMatch())
+        throw std::runtime_error("The size of the sections' content are not compatible with the structured grid.");
+    if (!save())
+        throw std::runtime_error("Could not flush the temp files (sections' bodies).");
+
+    open(true);
+    TextFile::append(fileHeader(dataset())
+                     + "DIMENSIONS " + std::to_string(p_dimensions[0]) + " " + std::to_string(p_dimensions[1])
+                     + " " + std::to_string(p_dimensions[2]) + "\n");
+    appendGeometry();
+    TextFile::nextLine();
+
+    appendAttributeSections(pointCount(), cellCount());
+    finishAssembly(removeSections);
+}
+
+bool VTKStructuredFile::appendNumbers(const double *numbers, const VTKStructuredFile::Size count) {
+    if (encoding() == Encoding::Binary)
+        return TextFile::appendBinary(numbers, count, NumberFormat::binary(NumberFormat::Storage::Float64)) == count * sizeof(double)
+                && TextFile::nextLine();
+
+    // The same text as the point section's body (i.e., each number followed by the seperator).
+    constexpr auto format = NumberFormat::of<double>(true);
+    char number[NumberFormat::maxLength];
+    std::string text;
+    for (Size done = 0; done < count; done += numbersPerLine) {
+        text.clear();
+        const auto size = std::min(count - done, numbersPerLine);
+        for (Size i = 0; i < size; i++) {
+            text.append(number, format.write(number, number + sizeof(number), numbers[done + i]));
+            text += " ";
+        }
+        text += "\n";
+        if (TextFile::append(text) != static_cast<CharCount>(text.size()))
+            return false;
+    }
+    return true;
+}
+
+bool VTKStructuredFile::appendVector(const std::string &keyword, const VTKStructuredFile::Vector &vector) {
+    constexpr auto format = NumberFormat::of<double>(true);
+    char number[NumberFormat::maxLength];
+    auto text = keyword;
+    for (const auto value : vector) {
+        text += " ";
+        text.append(number, format.write(number, number + sizeof(number), value));
+    }
+    text += "\n";
+    return TextFile::append(text) == static_cast<CharCount>(text.size());
+}
+
+bool VTKStructuredFile::sectionBodySizesMatch() const {
+    return attributeSizesMatch(pointCount(), cellCount());
+}
+
+} // namespace exporting
@@ -0,0 +1,125 @@
+//
+//  VTKStructuredFile.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef VTKSTRUCTUREDFILE_H
+#define VTKSTRUCTUREDFILE_H
+
+#include "VTKAttributeFile.h"
+#include <array>
+
+/**
+ * The exporting namespace provides the means to handle exporting simulation data to files.
+ */
+namespace exporting {
+
+/**
+ * @brief The VTKStructuredFile class is the base of the legacy vtk files whose cells are implicit in a structured
+ *        grid of points (i.e., STRUCTURED_POINTS, RECTILINEAR_GRID, and STRUCTURED_GRID datasets).
+ * @details The attributes are appended exactly as for the VTKFile (see VTKAttributeFile); the points are ordered by x first, then y, then z,
+ *          and the cells likewise. The derived classes only provide the dataset name and its geometry.
+ * @note The class is not default constructable.
+ */
+class VTKStructuredFile: public VTKAttributeFile
+{
+public:
+
+    using Dimensions = std::array<Size, 3>;     // The number of the points along the x, y, and z.
+    using Vector = std::array<double, 3>;
+
+    /**
+     * @brief The constructor.
+     * @param name The name of the file (the path to the file included).
+     * @param dimensions The number of the points along the x, y, and z.
+     * @param extension The extention of the file without the dot(.).
+     * @throws If any of the dimensions is zero.
+     */
+    explicit VTKStructuredFile(const std::string &name,
+                               const Dimensions &dimensions,
+                               const std::string &extension = "vtk");
+
+    /**
+     * @brief The constructor.
+     * @param path The directory path of the file.
+     * @param name The name of the file.
+     * @param dimensions The number of the points along the x, y, and z.
+     * @param extension The extention of the file without the dot(.).
+     * @throws If any of the dimensions is zero.
+     */
+    explicit VTKStructuredFile(const std::string &path,
+                               const std::string &name,
+                               const Dimensions &dimensions,
+                               const std::string &extension);
+
+    virtual ~VTKStructuredFile() = default;
+
+    /**
+     * @brief Gives the number of the points along the x, y, and z.
+     */
+    const Dimensions & dimensions() const;
+
+    /**
+     * @brief Gives the number of the points of the grid.
+     */
+    Size pointCount() const;
+
+    /**
+     * @brief Gives the number of the cells of the grid (i.e., the flat dimensions have no cells along them).
+     */
+    Size cellCount() const;
+
+    /**
+     * @brief Assembles the sections headers and bodies to create the vtk file.
+     * @note The vtk file can be assembled any time if the sections are not removed.
+     * @param removeSections If true, removes the temp files of the section bodies afterward.
+     * @throws If the size of the sections' content are not compatible with the grid.
+     */
+    virtual void assemble(bool removeSections = true) override;
+
+protected:
+
+    /**
+     * @brief Gives the name of the dataset (e.g., STRUCTURED_POINTS).
+     */
+    virtual std::string dataset() const = 0;
+
+    /**
+     * @brief Appends the geometry of the grid (i.e., the lines after the DIMENSIONS line).
+     * @throws If the content of the geometry could not be appended.
+     */
+    virtual void appendGeometry() = 0;
+
+    /**
+     * @brief Appends an array of numbers as the vtk sections' bodies would hold them, ending its last line.
+     * @param numbers The begining of the array.
+     * @param count The number of the numbers.
+     * @return True if successful, false otherwise.
+     */
+    bool appendNumbers(const double * numbers, const Size count);
+
+    /**
+     * @brief Appends a line of three numbers (e.g., the ORIGIN line).
+     * @param keyword The keyword of the line.
+     * @param vector The numbers.
+     * @return True if successful, false otherwise.
+     */
+    bool appendVector(const std::string & keyword, const Vector & vector);
+
+    /**
+     * @brief Computes whether the section's bodies have a compatible sizes with the grid or not.
+     */
+    virtual bool sectionBodySizesMatch() const;
+
+private:
+
+    Dimensions p_dimensions;    // The number of the points along the x, y, and z.
+
+};
+
+} // namespace exporting
+
+#endif // VTKSTRUCTUREDFILE_H
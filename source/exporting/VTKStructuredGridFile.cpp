@@ -0,0 +1,80 @@
+//
+//  VTKStructuredGridFile.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "VTKStructuredGridFile.h"
+#include <stdexcept>
+
+namespace exporting {
+
+VTKStructuredGridFile::VTKStructuredGridFile(const std::string &name,
+                                             const VTKStructuredGridFile::Dimensions &dimensions,
+                                             const std::string &extension)
+    : VTKStructuredFile{name, dimensions, extension}
+    , p_pointSection{name}
+{
+}
+
+VTKStructuredGridFile::VTKStructuredGridFile(const std::string &path,
+                                             const std::string &name,
+                                             const VTKStructuredGridFile::Dimensions &dimensions,
+                                             const std::string &extension)
+    : VTKStructuredGridFile{path + name, dimensions, extension}
+{
+}
+
+VTKStructuredGridFile::PointIndex VTKStructuredGridFile::appendPoint(const double x, const double y, const double z) {
+    return p_pointSection.appendPoint(x, y, z);
+}
+
+VTKStructuredGridFile::PointIndex VTKStructuredGridFile::appendPoints(Span<const double> xyz) {
+    return p_pointSection.appendPoints(xyz);
+}
+
+VTKStructuredGridFile::PointIndex VTKStructuredGridFile::appendPoints(Span<const double> x, Span<const double> y, Span<const double> z) {
+    return p_pointSection.appendPoints(x, y, z);
+}
+
+VTKStructuredGridFile::PointIndex VTKStructuredGridFile::appendPoints(StridedSpan<const double> points) {
+    return p_pointSection.appendPoints(points);
+}
+
+bool VTKStructuredGridFile::save() {
+    return p_pointSection.save() && VTKStructuredFile::save();
+}
+
+void VTKStructuredGridFile::setEncoding(const VTKStructuredGridFile::Encoding encoding) {
+    p_pointSection.setEncoding(encoding);
+    VTKStructuredFile::setEncoding(encoding);
+}
+
+void VTKStructuredGridFile::setSpillThreshold(const VTKStructuredGridFile::Size threshold) {
+    p_pointSection.setSpillThreshold(threshold);
+    VTKStructuredFile::setSpillThreshold(threshold);
+}
+
+std::string VTKStructuredGridFile::dataset() const {
+    return "STRUCTURED_GRID";
+}
+
+void VTKStructuredGridFile::appendGeometry() {
+    if (TextFile::append(p_pointSection.header()) <= 0 || !TextFile::nextLine()
+            || !TextFile::appendContent(p_pointSection.body()))
+        throw std::runtime_error("Could not append the content of the point section.");
+    if (encoding() == Encoding::Ascii && p_pointSection.pointCount() % 3)
+        TextFile::nextLine();
+}
+
+bool VTKStructuredGridFile::removeTemperoryFiles() {
+    return p_pointSection.removeBody() && VTKStructuredFile::removeTemperoryFiles();
+}
+
+bool VTKStructuredGridFile::sectionBodySizesMatch() const {
+    return p_pointSection.pointCount() == pointCount() && VTKStructuredFile::sectionBodySizesMatch();
+}
+
+} // namespace exporting
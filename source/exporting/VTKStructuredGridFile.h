@@ -0,0 +1,120 @@
+//
+//  VTKStructuredGridFile.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef VTKSTRUCTUREDGRIDFILE_H
+#define VTKSTRUCTUREDGRIDFILE_H
+
+#include "VTKStructuredFile.h"
+#include "vtk/VTKPointSection.h"
+
+/**
+ * The exporting namespace provides the means to handle exporting simulation data to files.
+ */
+namespace exporting {
+
+/**
+ * @brief The VTKStructuredGridFile class provides the means to handle exporting data on a curvilinear grid (i.e., a
+ *        STRUCTURED_GRID dataset) to a legacy vtk file.
+ * @details The points are appended explicitly (x first, then y, then z), exactly as to the point section of the
+ *          VTKFile, and the cells are implicit in their order.
+ * @note The class is not default constructable.
+ */
+class VTKStructuredGridFile: public VTKStructuredFile
+{
+public:
+
+    using PointIndex = VTKPointSection::PointIndex;
+
+    /**
+     * @brief The constructor.
+     * @param name The name of the file (the path to the file included).
+     * @param dimensions The number of the points along the x, y, and z.
+     * @param extension The extention of the file without the dot(.).
+     * @throws If any of the dimensions is zero.
+     */
+    explicit VTKStructuredGridFile(const std::string &name,
+                                   const Dimensions &dimensions,
+                                   const std::string &extension = "vtk");
+
+    /**
+     * @brief The constructor.
+     * @param path The directory path of the file.
+     * @param name The name of the file.
+     * @param dimensions The number of the points along the x, y, and z.
+     * @param extension The extention of the file without the dot(.).
+     * @throws If any of the dimensions is zero.
+     */
+    explicit VTKStructuredGridFile(const std::string &path,
+                                   const std::string &name,
+                                   const Dimensions &dimensions,
+                                   const std::string &extension);
+
+    /**
+     * @brief Append a point to the vtk point section's body's file (temp file).
+     * @param x The x of the point.
+     * @param y The y of the point.
+     * @param z The z of the point.
+     * @return The index of the added point.
+     */
+    PointIndex appendPoint(const double x, const double y, const double z);
+
+    /**
+     * @brief Append packed points to the vtk point section's body's file (temp file) without copying them.
+     * @param xyz The dimension of the points in sereis (i.g., x_0, y_0, z_0, x_1, y_1, ...).
+     * @return The index of the first added point (i.e., the points have consecutive indexes).
+     * @throws If the dimensions size is not a factor of 3.
+     */
+    PointIndex appendPoints(Span<const double> xyz);
+
+    /**
+     * @brief Append points stored as structure of arrays (SoA) to the vtk point section's body's file (temp file) without copying them.
+     * @param x The x of the points.
+     * @param y The y of the points.
+     * @param z The z of the points.
+     * @return The index of the first added point (i.e., the points have consecutive indexes).
+     * @throws If the sizes of the x, y, and z are not the same.
+     */
+    PointIndex appendPoints(Span<const double> x, Span<const double> y, Span<const double> z);
+
+    /**
+     * @brief Append points embedded inside a larger array to the vtk point section's body's file (temp file) without copying the array.
+     * @note The x, y, and z of each point are read contiguously from the begining of each element.
+     * @param points The strided view of the points.
+     * @return The index of the first added point (i.e., the points have consecutive indexes).
+     */
+    PointIndex appendPoints(StridedSpan<const double> points);
+
+    virtual bool save() override;
+
+    virtual void setEncoding(const Encoding encoding) override;
+
+    virtual void setSpillThreshold(const Size threshold) override;
+
+protected:
+
+    virtual std::string dataset() const override;
+
+    virtual void appendGeometry() override;
+
+    virtual bool removeTemperoryFiles() override;
+
+    /**
+     * @brief Computes whether the section's bodies have a compatible sizes with the grid or not.
+     * @note The number of the appended points should be the same as the points of the grid.
+     */
+    virtual bool sectionBodySizesMatch() const override;
+
+private:
+
+    VTKPointSection p_pointSection;
+
+};
+
+} // namespace exporting
+
+#endif // VTKSTRUCTUREDGRIDFILE_H
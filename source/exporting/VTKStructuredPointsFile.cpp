@@ -0,0 +1,52 @@
+//
+//  VTKStructuredPointsFile.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "VTKStructuredPointsFile.h"
+#include <stdexcept>
+
+namespace exporting {
+
+VTKStructuredPointsFile::VTKStructuredPointsFile(const std::string &name,
+                                                 const VTKStructuredPointsFile::Dimensions &dimensions,
+                                                 const VTKStructuredPointsFile::Vector &spacing,
+                                                 const VTKStructuredPointsFile::Vector &origin,
+                                                 const std::string &extension)
+    : VTKStructuredFile{name, dimensions, extension}
+    , p_origin{origin}
+    , p_spacing{spacing}
+{
+}
+
+VTKStructuredPointsFile::VTKStructuredPointsFile(const std::string &path,
+                                                 const std::string &name,
+                                                 const VTKStructuredPointsFile::Dimensions &dimensions,
+                                                 const VTKStructuredPointsFile::Vector &spacing,
+                                                 const VTKStructuredPointsFile::Vector &origin,
+                                                 const std::string &extension)
+    : VTKStructuredPointsFile{path + name, dimensions, spacing, origin, extension}
+{
+}
+
+const VTKStructuredPointsFile::Vector &VTKStructuredPointsFile::origin() const {
+    return p_origin;
+}
+
+const VTKStructuredPointsFile::Vector &VTKStructuredPointsFile::spacing() const {
+    return p_spacing;
+}
+
+std::string VTKStructuredPointsFile::dataset() const {
+    return "STRUCTURED_POINTS";
+}
+
+void VTKStructuredPointsFile::appendGeometry() {
+    if (!appendVector("ORIGIN", p_origin) || !appendVector("SPACING", p_spacing))
+        throw std::runtime_error("Could not append the origin and spacing of the structured points.");
+}
+
+} // namespace exporting
@@ -0,0 +1,86 @@
+//
+//  VTKStructuredPointsFile.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef VTKSTRUCTUREDPOINTSFILE_H
+#define VTKSTRUCTUREDPOINTSFILE_H
+
+#include "VTKStructuredFile.h"
+
+/**
+ * The exporting namespace provides the means to handle exporting simulation data to files.
+ */
+namespace exporting {
+
+/**
+ * @brief The VTKStructuredPointsFile class provides the means to handle exporting data on a uniform grid (i.e., a
+ *        STRUCTURED_POINTS dataset) to a legacy vtk file.
+ * @details The points are given by the origin and the spacing of the grid, only the attributes are stored.
+ * @note The class is not default constructable.
+ */
+class VTKStructuredPointsFile: public VTKStructuredFile
+{
+public:
+
+    /**
+     * @brief The constructor.
+     * @param name The name of the file (the path to the file included).
+     * @param dimensions The number of the points along the x, y, and z.
+     * @param spacing The distance of the points along the x, y, and z.
+     * @param origin The location of the first point.
+     * @param extension The extention of the file without the dot(.).
+     * @throws If any of the dimensions is zero.
+     */
+    explicit VTKStructuredPointsFile(const std::string &name,
+                                     const Dimensions &dimensions,
+                                     const Vector &spacing = {1, 1, 1},
+                                     const Vector &origin = {0, 0, 0},
+                                     const std::string &extension = "vtk");
+
+    /**
+     * @brief The constructor.
+     * @param path The directory path of the file.
+     * @param name The name of the file.
+     * @param dimensions The number of the points along the x, y, and z.
+     * @param spacing The distance of the points along the x, y, and z.
+     * @param origin The location of the first point.
+     * @param extension The extention of the file without the dot(.).
+     * @throws If any of the dimensions is zero.
+     */
+    explicit VTKStructuredPointsFile(const std::string &path,
+                                     const std::string &name,
+                                     const Dimensions &dimensions,
+                                     const Vector &spacing,
+                                     const Vector &origin,
+                                     const std::string &extension);
+
+    /**
+     * @brief Gives the location of the first point.
+     */
+    const Vector & origin() const;
+
+    /**
+     * @brief Gives the distance of the points along the x, y, and z.
+     */
+    const Vector & spacing() const;
+
+protected:
+
+    virtual std::string dataset() const override;
+
+    virtual void appendGeometry() override;
+
+private:
+
+    Vector p_origin;    // The location of the first point.
+    Vector p_spacing;   // The distance of the points along the x, y, and z.
+
+};
+
+} // namespace exporting
+
+#endif // VTKSTRUCTUREDPOINTSFILE_H
@@ -0,0 +1,252 @@
+//
+//  VTKWriterThread.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "VTKWriterThread.h"
+#include <algorithm>
+#include <chrono>
+
+namespace exporting {
+
+namespace {
+
+/**
+ * @brief Waits a little longer each time a thread finds nothing to do (i.e., yields first, then sleeps).
+ * @param idle The number of the times the thread found nothing to do in a row.
+ */
+void backOff(const std::size_t idle) {
+    if (idle < 64)
+        std::this_thread::yield();
+    else
+        std::this_thread::sleep_for(std::chrono::microseconds(std::min<std::size_t>(idle, 500)));
+}
+
+} // namespace
+
+VTKWriterThread::Entity::Entity()
+    : p_kind{Kind::Points}
+    , p_type{VTKCell::Vertex}
+    , p_size{0}
+    , p_attributeCount{0}
+{
+}
+
+VTKWriterThread::Entity::Entity(const VTKWriterThread::CellType type, Span<const VTKWriterThread::Point3> points)
+    : Entity{points}
+{
+    p_kind = Kind::Cell;
+    p_type = type;
+}
+
+VTKWriterThread::Entity::Entity(const VTKWriterThread::CellType type, std::initializer_list<VTKWriterThread::Point3> points)
+    : Entity{type, Span<const Point3>(points.begin(), points.size())}
+{
+}
+
+VTKWriterThread::Entity::Entity(const VTKWriterThread::CellType type, Span<const VTKWriterThread::PointIndex> cellPointsMap)
+    : Entity{}
+{
+    if (cellPointsMap.size() > maxIndexes)
+        throw std::range_error("The cell has too many points for the writer thread, append it to the vtk file directly.");
+    p_kind = Kind::MappedCell;
+    p_type = type;
+    p_size = cellPointsMap.size();
+    std::copy(cellPointsMap.begin(), cellPointsMap.end(), p_indexes);
+}
+
+VTKWriterThread::Entity::Entity(Span<const VTKWriterThread::Point3> points)
+    : Entity{}
+{
+    if (points.size() > maxPoints)
+        throw std::range_error("The entity has too many points for the writer thread, append it to the vtk file directly.");
+    p_size = points.size();
+    for (Size i = 0; i < points.size(); i++)
+        std::copy(points[i].begin(), points[i].end(), p_points + 3 * i);
+}
+
+VTKWriterThread::Size VTKWriterThread::Entity::pointCount() const {
+    return (p_kind == Kind::MappedCell) ? 0 : p_size;
+}
+
+bool VTKWriterThread::Entity::hasCell() const {
+    return p_kind != Kind::Points;
+}
+
+VTKWriterThread::Entity &VTKWriterThread::Entity::appendAttribute(const VTKWriterThread::Attribute attribute,
+                                                                  Span<const double> values) {
+    const auto begin = (p_attributeCount) ? p_ends[p_attributeCount - 1] : 0;
+    if (p_attributeCount == maxAttributes)
+        throw std::range_error("The entity has too many attributes for the writer thread.");
+    if (begin + values.size() > maxValues)
+        throw std::range_error("The entity has too many attribute values for the writer thread.");
+    std::copy(values.begin(), values.end(), p_values + begin);
+    p_attributes[p_attributeCount] = attribute;
+    p_ends[p_attributeCount++] = begin + values.size();
+    return *this;
+}
+
+VTKWriterThread::Entity &VTKWriterThread::Entity::appendAttribute(const VTKWriterThread::Attribute attribute,
+                                                                  std::initializer_list<double> values) {
+    return appendAttribute(attribute, Span<const double>(values.begin(), values.size()));
+}
+
+VTKWriterThread::VTKWriterThread(VTKFile &file,
+                                 const VTKWriterThread::Size capacity,
+                                 const VTKWriterThread::FullPolicy policy)
+    : p_file{file}
+    , p_attributes{}
+    , p_ring{capacity}
+    , p_policy{policy}
+    , p_pushed{0}
+    , p_written{0}
+    , p_dropped{0}
+    , p_stop{false}
+    , p_exception{}
+    , p_thread{}
+{
+    p_thread = std::thread(&VTKWriterThread::run, this);
+}
+
+VTKWriterThread::~VTKWriterThread() {
+    p_stop = true;
+    if (p_thread.joinable())
+        p_thread.join();
+}
+
+VTKWriterThread::Size VTKWriterThread::capacity() const {
+    return p_ring.capacity();
+}
+
+VTKWriterThread::Size VTKWriterThread::dropped() const {
+    return p_dropped;
+}
+
+VTKWriterThread::Attribute VTKWriterThread::attribute(const std::string &name) {
+    flush(); // The writer thread might be appending to the sections meanwhile.
+    p_attributes.emplace_back(&p_file[name]);
+    return p_attributes.size() - 1;
+}
+
+bool VTKWriterThread::append(const VTKWriterThread::Entity &entity) {
+    check(entity);
+    return push(entity);
+}
+
+bool VTKWriterThread::appendCell(const VTKWriterThread::CellType type, Span<const VTKWriterThread::Point3> points) {
+    return push(Entity(type, points));
+}
+
+bool VTKWriterThread::appendCell(const VTKWriterThread::CellType type, std::initializer_list<VTKWriterThread::Point3> points) {
+    return push(Entity(type, points));
+}
+
+bool VTKWriterThread::appendCell(const VTKWriterThread::CellType type, Span<const VTKWriterThread::PointIndex> cellPointsMap) {
+    return push(Entity(type, cellPointsMap));
+}
+
+bool VTKWriterThread::appendPoints(Span<const VTKWriterThread::Point3> points) {
+    return push(Entity(points));
+}
+
+void VTKWriterThread::flush() {
+    for (std::size_t idle = 0; p_written.load(std::memory_order_acquire) != p_pushed.load(std::memory_order_acquire); idle++)
+        backOff(idle);
+    if (p_exception) {
+        const auto exception = p_exception;
+        p_exception = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+void VTKWriterThread::check(const VTKWriterThread::Entity &entity) const {
+    using Source = VTKAttributeSection::SourceType;
+    for (Size i = 0; i < entity.p_attributeCount; i++) {
+        const auto attribute = entity.p_attributes[i];
+        if (attribute >= p_attributes.size())
+            throw std::out_of_range("The attribute handle is not given by the writer thread.");
+        for (Size j = 0; j < i; j++)
+            if (entity.p_attributes[j] == attribute)
+                throw std::logic_error("The entity holds the values of an attribute more than once.");
+
+        const auto & section = *p_attributes[attribute];
+        auto expected = section.componentCount();
+        if (section.source() == Source::Point) {
+            if (!entity.pointCount() && entity.hasCell())
+                throw std::logic_error("The cell on the appended points has no points to hold the point attribute values.");
+            if (p_file.isWelding())
+                throw std::logic_error("The points of the entity might be welded, their attribute values cannot follow them.");
+            expected *= entity.pointCount();
+        } else if (!entity.hasCell()) {
+            throw std::logic_error("The points without a cell cannot hold the cell attribute values.");
+        }
+        const auto begin = (i) ? entity.p_ends[i - 1] : 0;
+        if (entity.p_ends[i] - begin != expected)
+            throw std::range_error("The number of the attribute values does not match the attribute and the entity.");
+    }
+}
+
+bool VTKWriterThread::push(const VTKWriterThread::Entity &entity) {
+    // Counted beforehand, so that flush waits for the record that is being pushed.
+    p_pushed.fetch_add(1, std::memory_order_acq_rel);
+    for (std::size_t idle = 0; !p_ring.tryPush(entity); idle++) {
+        if (p_policy == FullPolicy::Drop) {
+            p_dropped++;
+            p_pushed.fetch_sub(1, std::memory_order_acq_rel);
+            return false;
+        }
+        backOff(idle);
+    }
+    return true;
+}
+
+void VTKWriterThread::run() {
+    Entity entity;
+    for (std::size_t idle = 0; true; idle++) {
+        if (p_ring.tryPop(entity)) {
+            if (!p_exception) {
+                try {
+                    write(entity);
+                } catch (...) {
+                    p_exception = std::current_exception();
+                }
+            }
+            p_written.fetch_add(1, std::memory_order_acq_rel);
+            idle = 0;
+        } else if (p_stop && p_written.load(std::memory_order_acquire) == p_pushed.load(std::memory_order_acquire)) {
+            return;
+        } else {
+            backOff(idle);
+        }
+    }
+}
+
+void VTKWriterThread::write(const VTKWriterThread::Entity &entity) {
+    using Kind = Entity::Kind;
+    switch (entity.p_kind) {
+    case Kind::Cell: {
+        Point3 points[maxPoints];
+        for (Size i = 0; i < entity.p_size; i++)
+            std::copy(entity.p_points + 3 * i, entity.p_points + 3 * i + 3, points[i].begin());
+        p_file.appendCell(entity.p_type, Span<const Point3>(points, entity.p_size));
+        break;
+    }
+    case Kind::MappedCell:
+        p_file.appendCells(entity.p_type, Span<const PointIndex>(entity.p_indexes, entity.p_size), entity.p_size);
+        break;
+    case Kind::Points:
+        if (entity.p_size)
+            p_file.appendPoints(Span<const double>(entity.p_points, 3 * entity.p_size));
+        break;
+    }
+    for (Size i = 0; i < entity.p_attributeCount; i++) {
+        const auto begin = (i) ? entity.p_ends[i - 1] : 0;
+        p_attributes[entity.p_attributes[i]]->appendAttribute(Span<const double>(entity.p_values + begin,
+                                                                                 entity.p_ends[i] - begin));
+    }
+}
+
+} // namespace exporting
@@ -0,0 +1,300 @@
+//
+//  VTKWriterThread.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef VTKWRITERTHREAD_H
+#define VTKWRITERTHREAD_H
+
+#include "file_system/RingBuffer.h"
+#include "VTKFile.h"
+#include <atomic>
+#include <exception>
+#include <initializer_list>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * The exporting namespace provides the means to handle exporting simulation data to files.
+ */
+namespace exporting {
+
+/**
+ * @brief The VTKWriterThread class provides the means to append the cells, points, and attribute values of a vtk file
+ *        from the simulation threads without formatting or writing anything on them.
+ * @details Each append call only copies one entity (i.e., a cell or a few points along their attribute values) into a
+ *          lock-free ring buffer (see file_system::RingBuffer) as a fixed-size record, a dedicated writer thread pops
+ *          the records in order and appends them to the vtk file (i.e., formats and writes them to the sections'
+ *          bodies). Since an entity is never split between records, the entities of different simulation threads
+ *          never interleave and the attribute values always stay with their points and cells.
+ * @note The entities of each simulation thread are written in the order they are appended.
+ * @note The vtk file should not be used directly until flush is called (or the writer thread is destroyed).
+ */
+class VTKWriterThread
+{
+public:
+
+    using CellType = VTKFile::CellType;
+    using Point3 = VTKFile::Point3;
+    using PointIndex = VTKFile::PointIndex;
+    using Size = std::size_t;
+    using Attribute = Size; // The handle of an attribute section (see attribute).
+
+    static constexpr Size maxPoints = 8;                // The maximum number of the points of an entity.
+    static constexpr Size maxIndexes = 3 * maxPoints;   // The maximum number of the points of a cell on appended points.
+    static constexpr Size maxAttributes = 4;            // The maximum number of the attributes of an entity.
+    static constexpr Size maxValues = 4 * maxPoints;    // The maximum number of the attribute values of an entity.
+    static constexpr Size defaultCapacity = 1 << 14;    // The default number of the records the ring buffer holds.
+
+    /**
+     * @brief The FullPolicy enum tells what happens to an append when the ring buffer is full.
+     */
+    enum class FullPolicy {
+        Block,  // Waits for the writer thread to make room.
+        Drop    // Drops the whole entity (see dropped).
+    };
+
+    /**
+     * @brief The Entity class holds a cell or a few points along their attribute values, to be appended as one record.
+     * @note The entity is built on the simulation thread (e.g., on its stack) without any heap allocation.
+     */
+    class Entity
+    {
+    public:
+
+        /**
+         * @brief The constructor of an empty entity (i.e., no points and no cell).
+         */
+        Entity();
+
+        /**
+         * @brief The constructor of a cell along its points (see VTKFile::appendCell).
+         * @param type The type of the cell.
+         * @param points The location of cell's vertices.
+         * @throws If the cell has more than maxPoints points.
+         */
+        Entity(const CellType type, Span<const Point3> points);
+
+        /**
+         * @brief The constructor of a cell along its points (see VTKFile::appendCell).
+         * @note Allows the brace-enclosed points, e.g., Entity(Cell::Line, {point0, point1}).
+         * @param type The type of the cell.
+         * @param points The location of cell's vertices.
+         * @throws If the cell has more than maxPoints points.
+         */
+        Entity(const CellType type, std::initializer_list<Point3> points);
+
+        /**
+         * @brief The constructor of a cell on the already appended points (see VTKFile::appendCells).
+         * @note The entity has no points of its own, so it can only hold the values of the cell attributes.
+         * @param type The type of the cell.
+         * @param cellPointsMap The point indexes of the cell.
+         * @throws If the cell has more than maxIndexes points.
+         */
+        Entity(const CellType type, Span<const PointIndex> cellPointsMap);
+
+        /**
+         * @brief The constructor of points without a cell (see VTKFile::appendPoints).
+         * @note The entity has no cell, so it can only hold the values of the point attributes.
+         * @param points The location of the points.
+         * @throws If there are more than maxPoints points.
+         */
+        explicit Entity(Span<const Point3> points);
+
+        /**
+         * @brief Gives the number of the points of the entity (i.e., not the points of a cell on appended points).
+         */
+        Size pointCount() const;
+
+        /**
+         * @brief Whether the entity holds a cell or not.
+         */
+        bool hasCell() const;
+
+        /**
+         * @brief Appends the values of an attribute for the entity.
+         * @note The values of a point attribute are the values of the points of the entity, in order, and the values
+         *       of a cell attribute are the value of its cell (e.g., 1, 3, or 9 numbers for a scalar, vector, or
+         *       tensor attribute). They are checked against the attribute once the entity is appended.
+         * @param attribute The handle of the attribute (see VTKWriterThread::attribute).
+         * @param values The values.
+         * @return The entity, to chain the calls.
+         * @throws If the entity would have more than maxAttributes attributes or maxValues values.
+         */
+        Entity & appendAttribute(const Attribute attribute, Span<const double> values);
+
+        /**
+         * @brief Appends the values of an attribute for the entity.
+         * @note Allows the brace-enclosed values, e.g., appendAttribute(temperature, {t0, t1}).
+         * @param attribute The handle of the attribute (see VTKWriterThread::attribute).
+         * @param values The values.
+         * @return The entity, to chain the calls.
+         * @throws If the entity would have more than maxAttributes attributes or maxValues values.
+         */
+        Entity & appendAttribute(const Attribute attribute, std::initializer_list<double> values);
+
+    private:
+
+        friend class VTKWriterThread;
+
+        /**
+         * @brief The Kind enum tells what an entity holds.
+         */
+        enum class Kind : unsigned char {
+            Cell,           // A cell along its points.
+            MappedCell,     // A cell on the already appended points.
+            Points          // The points without a cell.
+        };
+
+        Kind p_kind;
+        CellType p_type;                        // The type of the cell.
+        Size p_size;                            // The number of the points or the point indexes.
+        union {
+            double p_points[3 * maxPoints];     // The packed points.
+            PointIndex p_indexes[maxIndexes];   // The point indexes of a mapped cell.
+        };
+        Size p_attributeCount;                  // The number of the attributes.
+        Attribute p_attributes[maxAttributes];  // The handles of the attributes.
+        Size p_ends[maxAttributes];             // The end of the values of each attribute inside the values.
+        double p_values[maxValues];             // The values of the attributes, attribute after attribute.
+
+    };
+
+    /**
+     * @brief The constructor, starts the writer thread.
+     * @param file The vtk file, should outlive this object.
+     * @param capacity The number of the records the ring buffer holds.
+     * @param policy What happens to an append when the ring buffer is full.
+     */
+    explicit VTKWriterThread(VTKFile & file,
+                             const Size capacity = defaultCapacity,
+                             const FullPolicy policy = FullPolicy::Block);
+
+    VTKWriterThread(const VTKWriterThread& other) = delete;
+    VTKWriterThread& operator =(const VTKWriterThread&) = delete;
+
+    /**
+     * @brief The deconstructor, writes the remaining records and stops the writer thread.
+     * @note The errors of the writer thread are ignored, call flush beforehand to receive them.
+     */
+    ~VTKWriterThread();
+
+    /**
+     * @brief Gives the number of the records the ring buffer holds.
+     */
+    Size capacity() const;
+
+    /**
+     * @brief Gives the number of the entities dropped since the ring buffer was full (see FullPolicy::Drop).
+     */
+    Size dropped() const;
+
+    /**
+     * @brief Gives the handle of an attribute section of the file, creating the section if it does not exist.
+     * @note Should be called after setting the type and source of the attribute and before the simulation threads
+     *       append to it (i.e., not concurrently).
+     * @param name The name of the attribute.
+     * @return The handle of the attribute.
+     */
+    Attribute attribute(const std::string & name);
+
+    /**
+     * @brief Appends an entity (i.e., its cell or points along its attribute values) as one record.
+     * @param entity The entity.
+     * @return True if the entity is queued, false if it is dropped.
+     * @throws If an attribute handle is not given by attribute.
+     * @throws If the number of the values of an attribute does not match the attribute and the entity.
+     */
+    bool append(const Entity & entity);
+
+    /**
+     * @brief Appends a cell along its points without any attribute values (see VTKFile::appendCell).
+     * @param type The type of the cell.
+     * @param points The location of cell's vertices.
+     * @return True if the cell is queued, false if it is dropped.
+     * @throws If the cell has more than maxPoints points.
+     */
+    bool appendCell(const CellType type, Span<const Point3> points);
+
+    /**
+     * @brief Appends a cell along its points without any attribute values (see VTKFile::appendCell).
+     * @note Allows the brace-enclosed points, e.g., appendCell(Cell::Line, {point0, point1}).
+     * @param type The type of the cell.
+     * @param points The location of cell's vertices.
+     * @return True if the cell is queued, false if it is dropped.
+     * @throws If the cell has more than maxPoints points.
+     */
+    bool appendCell(const CellType type, std::initializer_list<Point3> points);
+
+    /**
+     * @brief Appends a cell on the already appended points without any attribute values (see VTKFile::appendCells).
+     * @param type The type of the cell.
+     * @param cellPointsMap The point indexes of the cell.
+     * @return True if the cell is queued, false if it is dropped.
+     * @throws If the cell has more than maxIndexes points.
+     */
+    bool appendCell(const CellType type, Span<const PointIndex> cellPointsMap);
+
+    /**
+     * @brief Appends points without any attribute values (see VTKFile::appendPoints).
+     * @param points The location of the points.
+     * @return True if the points are queued, false if they are dropped.
+     * @throws If there are more than maxPoints points.
+     */
+    bool appendPoints(Span<const Point3> points);
+
+    /**
+     * @brief Blocks the caller until all the queued records are written to the file.
+     * @note Should not be called while the simulation threads are appending.
+     * @throws The first error of the writer thread (e.g., an invalid cell), the records after it are dropped.
+     */
+    void flush();
+
+private:
+
+    /**
+     * @brief Checks whether the attribute values of an entity match their attributes or not.
+     * @param entity The entity.
+     * @throws If an attribute handle is not given by attribute.
+     * @throws If the number of the values of an attribute does not match the attribute and the entity.
+     */
+    void check(const Entity & entity) const;
+
+    /**
+     * @brief Pushes a record to the ring buffer, according to the full policy.
+     * @param entity The record.
+     * @return True if the record is queued, false if it is dropped.
+     */
+    bool push(const Entity & entity);
+
+    /**
+     * @brief Writes the records until the writer thread is stoped and the ring buffer is empty.
+     */
+    void run();
+
+    /**
+     * @brief Appends a record to the file (i.e., its cell or points, then its attribute values).
+     * @param entity The record.
+     */
+    void write(const Entity & entity);
+
+    VTKFile & p_file;                                   // The vtk file.
+    std::vector<VTKAttributeSection *> p_attributes;    // The attribute sections of the handles.
+    file_system::RingBuffer<Entity> p_ring;             // The queued records.
+    FullPolicy p_policy;                                // What happens to an append when the ring buffer is full.
+    std::atomic<Size> p_pushed;                         // The number of the queued records.
+    std::atomic<Size> p_written;                        // The number of the records handled by the writer thread.
+    std::atomic<Size> p_dropped;                        // The number of the dropped records.
+    std::atomic<bool> p_stop;                           // Whether the writer thread should stop or not.
+    std::exception_ptr p_exception;                     // The first error of the writer thread.
+    std::thread p_thread;                               // The writer thread.
+
+};
+
+} // namespace exporting
+
+#endif // VTKWRITERTHREAD_H
@@ -0,0 +1,263 @@
+//
+//  VTUFile.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "VTUFile.h"
+#include <algorithm>
+#include <limits>
+
+namespace exporting {
+
+namespace {
+
+constexpr std::size_t blockSize = 1 << 13; // The number of values written to the file at once.
+
+} // namespace
+
+VTUFile::VTUFile(const std::string &name, const std::string &extension)
+    : VTKFile{name, extension}
+    , p_indexType{IndexType::Int32}
+{
+    VTKFile::setEncoding(Encoding::Binary);
+}
+
+VTUFile::VTUFile(const std::string &path,
+                 const std::string &name,
+                 const std::string &extension)
+    : VTUFile{path + name, extension}
+{
+}
+
+VTUFile::VTUFile(VTUFile &&other)
+    : VTKFile{std::move(other)}
+    , p_indexType{other.p_indexType}
+{
+}
+
+void VTUFile::assemble(bool removeSections) {
+    checkSectionsOwned();
+    mergeShards();
+    if (!sectionBodySizesMatch())
+        throw std::runtime_error("The size of the sections' content are not compatible..");
+    if (pointSection().encoding() != Encoding::Binary)
+        throw std::runtime_error("The configuration of the vtu file should be in the binary encoding.");
+
+    saveSections(); // Flush the tempfiles.
+    if (!isOpen())
+        open(true);
+
+    using Source = VTKAttributeSection::SourceType;
+    const auto indexSize = NumberFormat::sizeOf(indexStorage());
+    const Offset pointCount = pointSection().pointCount();
+    const Offset cellCount = VTKFile::cellCount();
+    const Offset connectivityCount = (isPointCloud()) ? pointCount : cellSection().pointCount();
+    const auto attributeBytes = [](const VTKAttributeSection & section) -> Offset {
+        return section.body().cellCount() * NumberFormat::sizeOf(section.format().storage());
+    };
+
+    // header
+    Offset offset = 0;
+    const auto nextOffset = [&offset](const Offset bytes) {
+        const auto ans = offset;
+        offset += sizeof(Offset) + bytes;
+        return ans;
+    };
+    TextFile::append("<?xml version=\"1.0\"?>\n");
+    TextFile::append("<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"BigEndian\" header_type=\"UInt64\">\n");
+    TextFile::append("  <UnstructuredGrid>\n");
+    TextFile::append("    <Piece NumberOfPoints=\"" + std::to_string(pointCount)
+                     + "\" NumberOfCells=\"" + std::to_string(cellCount) + "\">\n");
+    for (const auto source : {Source::Point, Source::Cell}) {
+        const std::string tag = (source == Source::Point) ? "PointData" : "CellData";
+        TextFile::append("      <" + tag + ">\n");
+        for (const auto & attributeSection : attributeSections()) {
+            const auto & section = *attributeSection.second;
+            if (section.source() == source)
+                appendDataArrayTag(to_string(section.format().storage()), section.attributeName(),
+                                   section.componentCount(), nextOffset(attributeBytes(section)));
+        }
+        TextFile::append("      </" + tag + ">\n");
+    }
+    TextFile::append("      <Points>\n");
+    appendDataArrayTag(to_string(Storage::Float64), "", 3, nextOffset(pointCount * 3 * sizeof(double)));
+    TextFile::append("      </Points>\n");
+    TextFile::append("      <Cells>\n");
+    appendDataArrayTag(to_string(indexStorage()), "connectivity", 1, nextOffset(connectivityCount * indexSize));
+    appendDataArrayTag(to_string(indexStorage()), "offsets", 1, nextOffset(cellCount * indexSize));
+    appendDataArrayTag(to_string(Storage::UInt8), "types", 1, nextOffset(cellCount));
+    TextFile::append("      </Cells>\n");
+    TextFile::append("    </Piece>\n");
+    TextFile::append("  </UnstructuredGrid>\n");
+
+    // Appended Data, in the same order as the tags
+    TextFile::append("  <AppendedData encoding=\"raw\">\n   _");
+    for (const auto source : {Source::Point, Source::Cell})
+        for (const auto & attributeSection : attributeSections())
+            if (attributeSection.second->source() == source)
+                appendSectionArray(*attributeSection.second, attributeBytes(*attributeSection.second));
+    appendSectionArray(pointSection(), pointCount * 3 * sizeof(double));
+    appendCellArray(false);
+    appendCellArray(true);
+    appendCellTypeArray();
+    TextFile::append("\n  </AppendedData>\n");
+    TextFile::append("</VTKFile>\n");
+
+    finishAssembly(removeSections);
+}
+
+std::shared_ptr<VTKFile> VTUFile::handOver() {
+    return std::shared_ptr<VTKFile>(new VTUFile(std::move(*this)));
+}
+
+VTUFile::IndexType VTUFile::indexType() const {
+    return p_indexType;
+}
+
+std::string VTUFile::parallelTags() const {
+    using Source = VTKAttributeSection::SourceType;
+    const auto arrayTag = [](const std::string & type, const std::string & name, const VTKAttributeSection::Size components) {
+        std::string tag = "      <PDataArray type=\"" + type + "\"";
+        if (!name.empty()) {
+            tag += " Name=\"";
+            for (const auto c : name)
+                tag += (c == '"') ? std::string("&quot;") : std::string(1, c);
+            tag += "\"";
+        }
+        return tag + " NumberOfComponents=\"" + std::to_string(components) + "\"/>\n";
+    };
+
+    std::string ans;
+    for (const auto source : {Source::Point, Source::Cell}) {
+        const std::string tag = (source == Source::Point) ? "PPointData" : "PCellData";
+        ans += "    <" + tag + ">\n";
+        for (const auto & attributeSection : attributeSections()) {
+            const auto & section = *attributeSection.second;
+            if (section.source() == source)
+                ans += arrayTag(to_string(section.format().storage()), section.attributeName(), section.componentCount());
+        }
+        ans += "    </" + tag + ">\n";
+    }
+    ans += "    <PPoints>\n";
+    ans += arrayTag(to_string(Storage::Float64), "", 3);
+    ans += "    </PPoints>\n";
+    return ans;
+}
+
+void VTUFile::setEncoding(const VTUFile::Encoding encoding) {
+    if (encoding != Encoding::Binary)
+        throw std::logic_error("The vtu file can only be in the binary encoding.");
+    VTKFile::setEncoding(encoding);
+}
+
+void VTUFile::setIndexType(const VTUFile::IndexType type) {
+    setCellIndexStorage((type == IndexType::Int64) ? Storage::Int64 : Storage::Int32);
+    p_indexType = type;
+}
+
+void VTUFile::appendDataArrayTag(const std::string &type,
+                                 const std::string &name,
+                                 const VTKAttributeSection::Size components,
+                                 const VTUFile::Offset offset) {
+    std::string tag = "        <DataArray type=\"" + type + "\"";
+    if (!name.empty()) {
+        tag += " Name=\"";
+        for (const auto c : name)
+            tag += (c == '"') ? std::string("&quot;") : std::string(1, c);
+        tag += "\"";
+    }
+    tag += " NumberOfComponents=\"" + std::to_string(components) + "\" format=\"appended\" offset=\""
+            + std::to_string(offset) + "\"/>\n";
+    TextFile::append(tag);
+}
+
+void VTUFile::appendCellArray(const bool offsets) {
+    const auto & section = cellSection();
+    const auto format = NumberFormat::binary(indexStorage());
+    if (isPointCloud()) {
+        // The implicit vertices: the connectivity is 0, 1, 2, ... and the offsets are 1, 2, 3, ...
+        const Offset count = pointSection().pointCount();
+        appendArrayHeader(count * NumberFormat::sizeOf(format.storage()));
+        std::int64_t block[blockSize];
+        for (Offset done = 0; done < count; done += blockSize) {
+            const auto size = std::min<Offset>(count - done, blockSize);
+            for (Offset i = 0; i < size; i++)
+                block[i] = done + i + offsets;
+            appendBinary(block, size, format);
+        }
+        return;
+    }
+    const Offset count = (offsets) ? section.cellCount() : section.pointCount();
+    appendArrayHeader(count * NumberFormat::sizeOf(format.storage()));
+    if (!count)
+        return;
+
+    // The cell section holds the point count of each cell followed by its point indexes.
+    std::vector<std::int64_t> values;
+    values.reserve(blockSize);
+    std::int64_t remainingPoints = 0;
+    std::int64_t end = 0;
+    const auto narrow = format.storage() == Storage::Int32;
+    section.readBinary([&](const std::int64_t * block, const std::size_t size) {
+        for (std::size_t i = 0; i < size; i++) {
+            if (narrow && block[i] > std::numeric_limits<std::int32_t>::max())
+                throw std::range_error("The point index does not fit in the Int32 index type of the vtu file.");
+            if (remainingPoints == 0) {
+                remainingPoints = block[i];
+                end += block[i];
+                if (offsets)
+                    values.emplace_back(end);
+            } else {
+                remainingPoints--;
+                if (!offsets)
+                    values.emplace_back(block[i]);
+            }
+            if (values.size() == blockSize) {
+                appendBinary(values.data(), values.size(), format);
+                values.clear();
+            }
+        }
+    });
+    appendBinary(values.data(), values.size(), format);
+}
+
+void VTUFile::appendArrayHeader(const VTUFile::Offset bytes) {
+    appendBinary(&bytes, 1, NumberFormat::binary(Storage::UInt64));
+}
+
+void VTUFile::appendCellTypeArray() {
+    const auto & runs = (isPointCloud()) ? VTKCellTypeSection::Runs{{Cell::Vertex, pointSection().pointCount()}}
+                                         : cellTypeSection().runs();
+    appendArrayHeader(VTKFile::cellCount());
+    const auto format = NumberFormat::binary(Storage::UInt8);
+    VTKCellTypeSection::expand(runs, [this, &format](const Cell::Code * codes, const VTKCellTypeSection::Size size) {
+        appendBinary(codes, size, format);
+    });
+}
+
+void VTUFile::appendSectionArray(const VTKSection &section, const VTUFile::Offset bytes) {
+    appendArrayHeader(bytes);
+    if (!TextFile::appendContent(section.body()))
+        throw std::runtime_error("Could not append the body of the " + VTKSection::to_string(section.type()) + " section.");
+}
+
+std::string VTUFile::to_string(const VTUFile::Storage storage) {
+    switch (storage) {
+    case Storage::UInt8:    return "UInt8";
+    case Storage::Int32:    return "Int32";
+    case Storage::Int64:    return "Int64";
+    case Storage::UInt64:   return "UInt64";
+    case Storage::Float32:  return "Float32";
+    case Storage::Float64:  return "Float64";
+    }
+    throw std::range_error("The storage type is out of known range.");
+}
+
+VTUFile::Storage VTUFile::indexStorage() const {
+    return (p_indexType == IndexType::Int64) ? Storage::Int64 : Storage::Int32;
+}
+
+} // namespace exporting
@@ -0,0 +1,169 @@
+//
+//  VTUFile.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef VTUFILE_H
+#define VTUFILE_H
+
+#include "VTKFile.h"
+
+/**
+ * The exporting namespace provides the means to handle exporting simulation data to files.
+ */
+namespace exporting {
+
+/**
+ * @brief The VTUFile class provides the means to handle exporting data to a vtk XML unstructured grid (.vtu) file.
+ * @details The cells, points, and attributes are appended exactly as for the VTKFile; the sections' bodies are
+ *          kept in the binary encoding on the temp files and streamed into a raw <AppendedData> block on assembly.
+ *          The connectivity, offsets, and types arrays are converted from the cell and cell_type sections chunk by chunk,
+ *          so the memory stays bounded regardless of the size of the grid.
+ * @note The class is not default constructable.
+ */
+class VTUFile: public VTKFile
+{
+public:
+
+    /**
+     * @brief The type of the connectivity and offsets arrays of the cells.
+     */
+    enum class IndexType {
+        Int32,
+        Int64
+    };
+
+    /**
+     * @brief The constructor.
+     * @param name The name of the file (the path to the file included).
+     * @param extension The extention of the file without the dot(.).
+     */
+    explicit VTUFile(const std::string &name,
+                     const std::string &extension = "vtu");
+
+    /**
+     * @brief The constructor.
+     * @param path The directory path of the file.
+     * @param name The name of the file.
+     * @param extension The extention of the file without the dot(.).
+     */
+    explicit VTUFile(const std::string &path,
+                     const std::string &name,
+                     const std::string &extension);
+
+    void enableDirectWrite() = delete;
+
+    /**
+     * @brief Sets the encoding of the file.
+     * @note The vtu file is always in the binary encoding (i.e., the raw appended data).
+     * @param encoding The new encoding.
+     * @throws If the encoding is not binary.
+     */
+    virtual void setEncoding(const Encoding encoding) override;
+
+    /**
+     * @brief Assembles the sections bodies into the appended data of the vtu file.
+     * @note The vtu file can be assembled any time if the sections are not removed.
+     * @param removeSections If true, removes the temp files of the section bodies afterward.
+     * @throws If the size of the sections' content are not compatible.
+     * @throws If the shared configuration is not in the binary encoding.
+     */
+    virtual void assemble(bool removeSections = true) override;
+
+    /**
+     * @brief Gives the type of the connectivity and offsets arrays.
+     */
+    IndexType indexType() const;
+
+    /**
+     * @brief Gives the declaration of the arrays of the file as the tags of a parallel vtu (.pvtu) index (i.e., the
+     *        <PPointData>, <PCellData>, and <PPoints> tags).
+     */
+    std::string parallelTags() const;
+
+    /**
+     * @brief Sets the type of the connectivity and offsets arrays.
+     * @note Int32 is enough for up to 2^31 point indexes per file, otherwise use Int64.
+     * @note Use this before appending the first cell, the cell section stores its indexes in the same type.
+     * @param type The new index type.
+     * @throws If the cell section's body is not empty.
+     */
+    void setIndexType(const IndexType type);
+
+protected:
+
+    /**
+     * @brief The move constructor, takes over the sections of the other file (see VTKFile::handOver).
+     * @param other The file to take the sections over from.
+     */
+    VTUFile(VTUFile && other);
+
+    /**
+     * @brief Creates the vtu file that takes over the sections of this file (e.g., for the background assembly).
+     */
+    virtual std::shared_ptr<VTKFile> handOver() override;
+
+private:
+
+    using Offset = std::uint64_t;
+    using Storage = NumberFormat::Storage;
+
+    /**
+     * @brief Appends the <DataArray> tag of an appended array.
+     * @param type The vtk type of the array values.
+     * @param name The name of the array (no name attribute if empty).
+     * @param components The number of components of the array.
+     * @param offset The offset of the array inside the appended data.
+     */
+    void appendDataArrayTag(const std::string & type,
+                            const std::string & name,
+                            const VTKAttributeSection::Size components,
+                            const Offset offset);
+
+    /**
+     * @brief Appends the connectivity or the offsets array converted from the cell section.
+     * @param offsets If true, appends the offsets array, the connectivity array otherwise.
+     * @throws If the cell section could not be read.
+     */
+    void appendCellArray(const bool offsets);
+
+    /**
+     * @brief Appends the header (i.e., the number of bytes) of an appended array.
+     * @param bytes The number of bytes of the array.
+     */
+    void appendArrayHeader(const Offset bytes);
+
+    /**
+     * @brief Appends the types array expanded from the runs of the cell_type section.
+     */
+    void appendCellTypeArray();
+
+    /**
+     * @brief Appends the content of a section's body as an appended array.
+     * @param section The section.
+     * @param bytes The number of bytes of the array.
+     * @throws If the section body could not be appended.
+     */
+    void appendSectionArray(const VTKSection & section, const Offset bytes);
+
+    /**
+     * @brief Gives the vtk type name of a storage type (e.g., Float64).
+     * @param storage The storage type.
+     */
+    static std::string to_string(const Storage storage);
+
+    /**
+     * @brief Gives the storage type of the connectivity and offsets arrays.
+     */
+    Storage indexStorage() const;
+
+    IndexType p_indexType;  // The type of the connectivity and offsets arrays.
+
+};
+
+} // namespace exporting
+
+#endif // VTUFILE_H
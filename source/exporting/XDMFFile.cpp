@@ -0,0 +1,307 @@
+//
+//  XDMFFile.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "XDMFFile.h"
+#include <charconv>
+#include <cstring>
+
+namespace exporting {
+
+namespace {
+
+constexpr std::size_t blockSize = 1 << 13; // The number of values converted at once.
+
+/**
+ * @brief Appends the big-endian values of a section's body to a blob in little-endian.
+ * @tparam T The type of the values (i.e., of the storage type of the section).
+ * @param blob The blob.
+ * @param body The section's body.
+ * @param storage The storage type of the values.
+ * @return The number of bytes appended to the blob.
+ * @throws If the section's body could not be read.
+ */
+template<typename T>
+std::uint64_t appendLittleEndian(TextFile & blob, const VTKSection::Body & body, const NumberFormat::Storage storage) {
+    const auto format = NumberFormat::binary(storage, NumberFormat::Endian::Little);
+    std::uint64_t ans = 0;
+    T values[blockSize];
+    const auto read = body.readContent(sizeof(values), [&](const char * bytes, const std::size_t size) {
+        const auto count = size / sizeof(T);
+        std::memcpy(values, bytes, count * sizeof(T));
+        if (ByteOrder::native() != ByteOrder::Endian::Big)
+            ByteOrder::swap(values, count);
+        ans += blob.appendBinary(values, count, format);
+    });
+    if (!read)
+        throw std::runtime_error("Could not open the section's body (" + body.fullName(true) + ").");
+    return ans;
+}
+
+/**
+ * @brief Appends the big-endian values of a section's body to a blob in little-endian.
+ * @param blob The blob.
+ * @param section The section.
+ * @return The number of bytes appended to the blob.
+ * @throws If the section's body could not be read.
+ */
+std::uint64_t appendLittleEndian(TextFile & blob, const VTKSection & section) {
+    using Storage = NumberFormat::Storage;
+    const auto storage = section.format().storage();
+    switch (storage) {
+    case Storage::UInt8:    return appendLittleEndian<std::uint8_t>(blob, section.body(), storage);
+    case Storage::Int32:    return appendLittleEndian<std::int32_t>(blob, section.body(), storage);
+    case Storage::Int64:    return appendLittleEndian<std::int64_t>(blob, section.body(), storage);
+    case Storage::UInt64:   return appendLittleEndian<std::uint64_t>(blob, section.body(), storage);
+    case Storage::Float32:  return appendLittleEndian<float>(blob, section.body(), storage);
+    case Storage::Float64:  return appendLittleEndian<double>(blob, section.body(), storage);
+    }
+    throw std::range_error("The storage type is out of known range.");
+}
+
+/**
+ * @brief The XDMFCell struct provides the code of a cell type inside an XDMF mixed topology.
+ */
+struct XDMFCell {
+    std::int64_t code;  // The XDMF code of the cell type.
+    bool sized;         // Whether the code is followed by the number of the points of the cell or not.
+};
+
+/**
+ * @brief Gives the XDMF counterpart of a vtk cell type.
+ * @param type The vtk cell type.
+ * @throws If the cell type has no XDMF counterpart (i.e., the triangle strips).
+ */
+XDMFCell xdmfCell(const VTKCell::Type type) {
+    using CT = VTKCell::Type;
+    switch (type) {
+    case CT::Vertex:
+    case CT::PolyVertex:            return {1, true};
+    case CT::Line:
+    case CT::PolyLine:              return {2, true};
+    case CT::Polygon:               return {3, true};
+    case CT::Triangle:              return {4, false};
+    case CT::Pixel:
+    case CT::Quad:                  return {5, false};
+    case CT::Tetra:                 return {6, false};
+    case CT::Pyramid:               return {7, false};
+    case CT::Wedge:                 return {8, false};
+    case CT::Voxel:
+    case CT::Hexahedron:            return {9, false};
+    case CT::QuadraticEdge:         return {34, false};
+    case CT::QuadraticTriangle:     return {36, false};
+    case CT::QuadraticQuad:         return {37, false};
+    case CT::QuadraticTetra:        return {38, false};
+    case CT::QuadraticPyramid:      return {39, false};
+    case CT::QuadraticWedge:        return {40, false};
+    case CT::QuadraticHexahedron:   return {48, false};
+    case CT::TriangleStrip:         break;
+    }
+    throw std::runtime_error("The cell type (" + std::to_string(VTKCell::code(type)) + ") has no XDMF counterpart.");
+}
+
+/**
+ * @brief Gives the shortest text that reads back to the same number.
+ * @param number The number.
+ */
+std::string to_text(const double number) {
+    char text[64];
+    return std::string(text, std::to_chars(text, text + sizeof(text), number).ptr);
+}
+
+/**
+ * @brief Gives the text of a name inside the quotes of an XML attribute.
+ * @param name The name.
+ */
+std::string quoted(const std::string & name) {
+    std::string ans;
+    for (const auto c : name)
+        ans += (c == '"') ? std::string("&quot;") : std::string(1, c);
+    return ans;
+}
+
+} // namespace
+
+XDMFFile::XDMFFile(const std::string &name, const std::string &extension)
+    : file_system::BaseFile{name, extension}
+    , p_dataBlob{name + "_data", "bin"}
+    , p_geometryBlob{name + "_geometry", "bin"}
+    , p_dataBytes{0}
+    , p_geometryBytes{0}
+    , p_geometry{}
+    , p_geometrySource{}
+    , p_stepCount{0}
+{
+}
+
+XDMFFile::XDMFFile(const std::string &path, const std::string &name, const std::string &extension)
+    : XDMFFile{path + name, extension}
+{
+}
+
+XDMFFile::Size XDMFFile::stepCount() const {
+    return p_stepCount;
+}
+
+void XDMFFile::appendStep(VTKFile &file, const double time, bool removeSections) {
+    file.mergeShards();
+    if (file.encoding() != VTKFile::Encoding::Binary || file.pointSection().encoding() != VTKFile::Encoding::Binary)
+        throw std::runtime_error("The vtk file of the step should be in the binary encoding.");
+    if (file.isDirectWrite())
+        throw std::logic_error("The points of the vtk file of the step should not be written directly.");
+    if (!file.sectionBodySizesMatch())
+        throw std::runtime_error("The size of the sections' content are not compatible..");
+    file.saveSections(); // Flush the tempfiles.
+
+    if (!p_stepCount) {
+        p_dataBlob.open(true);
+        p_geometryBlob.open(true);
+    }
+
+    // The geometry of a locked shared configuration is written once.
+    const auto & configuration = file.p_configuration;
+    const bool shared = configuration && configuration->isLocked();
+    if (!shared || configuration != p_geometrySource) {
+        p_geometry = appendGeometry(file);
+        p_geometrySource = (shared) ? configuration : nullptr;
+    }
+
+    std::string grid = "      <Grid Name=\"step_" + std::to_string(p_stepCount) + "\" GridType=\"Uniform\">\n";
+    grid += "        <Time Value=\"" + to_text(time) + "\"/>\n";
+    grid += p_geometry;
+    for (const auto source : {VTKAttributeSection::SourceType::Point, VTKAttributeSection::SourceType::Cell}) {
+        for (const auto & attributeSection : file.attributeSections()) {
+            const auto & section = *attributeSection.second;
+            if (section.source() != source)
+                continue;
+            const auto components = section.componentCount();
+            const auto rows = section.body().cellCount() / components;
+            const auto dimensions = std::to_string(rows) + ((components > 1) ? " " + std::to_string(components) : "");
+            const auto type = (components == 1) ? "Scalar"
+                            : (components == 3) ? "Vector"
+                            : (components == 6) ? "Tensor6"
+                            : (components == 9) ? "Tensor" : "Matrix";
+            const auto center = (source == VTKAttributeSection::SourceType::Point) ? "Node" : "Cell";
+            grid += "        <Attribute Name=\"" + quoted(section.attributeName()) + "\" AttributeType=\"" + type
+                    + "\" Center=\"" + center + "\">\n";
+            grid += "          " + dataItem(section.format().storage(), dimensions, p_dataBytes, p_dataBlob);
+            grid += "        </Attribute>\n";
+            p_dataBytes += appendLittleEndian(p_dataBlob, section);
+        }
+    }
+    grid += "      </Grid>\n";
+
+    // The blobs are complete before the step is listed.
+    if (!p_dataBlob.save() || !p_geometryBlob.save())
+        throw std::runtime_error("Could not write the blobs of the xdmf file.");
+    const auto head = "<?xml version=\"1.0\" ?>\n"
+                      "<Xdmf Version=\"3.0\">\n"
+                      "  <Domain>\n"
+                      "    <Grid Name=\"" + quoted(name(false)) + "\" GridType=\"Collection\" CollectionType=\"Temporal\">\n";
+    if (!insertBeforeTail(grid, "    </Grid>\n  </Domain>\n</Xdmf>\n", head, !p_stepCount))
+        throw std::runtime_error("Could not write the xdmf file (" + fullName(true) + ").");
+    p_stepCount++;
+
+    if (removeSections)
+        if (!file.removeTemperoryFiles())
+            throw std::runtime_error("Could not remove the temp files (sections' bodies).");
+}
+
+std::string XDMFFile::appendGeometry(const VTKFile &file) {
+    const auto & points = file.pointSection();
+    const Offset pointCount = points.pointCount();
+    const Offset cellCount = file.cellCount();
+
+    // The mixed topology: the XDMF code of each cell, its number of points (for the sized ones), and its points.
+    const auto format = NumberFormat::binary(Storage::Int64, NumberFormat::Endian::Little);
+    const auto topologyOffset = p_geometryBytes;
+    Offset topologyCount = 0;
+    std::vector<std::int64_t> topology;
+    topology.reserve(blockSize);
+    const auto flush = [this, &topology, &topologyCount, &format]() {
+        p_geometryBytes += p_geometryBlob.appendBinary(topology.data(), topology.size(), format);
+        topologyCount += topology.size();
+        topology.clear();
+    };
+    if (file.isPointCloud()) {
+        for (Offset i = 0; i < pointCount; i++) {
+            topology.insert(topology.end(), {1, 1, static_cast<std::int64_t>(i)});
+            if (topology.size() >= blockSize)
+                flush();
+        }
+    } else {
+        // The cell section holds the point count of each cell followed by its point indexes.
+        const auto & runs = file.cellTypeSection().runs();
+        auto run = runs.begin();
+        VTKCellTypeSection::Size runDone = 0;
+        std::vector<std::int64_t> cell;
+        std::int64_t remainingPoints = 0;
+        const auto appendCell = [&]() {
+            while (runDone == run->count) {
+                run++;
+                runDone = 0;
+            }
+            runDone++;
+            const auto xdmf = xdmfCell(run->type);
+            if (run->type == VTKCell::Type::Pixel || run->type == VTKCell::Type::Voxel) {
+                std::swap(cell[2], cell[3]); // The pixel and voxel are the quad and hexahedron, ordered by axes.
+                if (run->type == VTKCell::Type::Voxel)
+                    std::swap(cell[6], cell[7]);
+            }
+            topology.emplace_back(xdmf.code);
+            if (xdmf.sized)
+                topology.emplace_back(cell.size());
+            topology.insert(topology.end(), cell.begin(), cell.end());
+            if (topology.size() >= blockSize)
+                flush();
+            cell.clear();
+        };
+        file.cellSection().readBinary([&](const std::int64_t * values, const std::size_t count) {
+            for (std::size_t i = 0; i < count; i++) {
+                if (remainingPoints == 0) {
+                    remainingPoints = values[i];
+                } else {
+                    cell.emplace_back(values[i]);
+                    if (--remainingPoints == 0)
+                        appendCell();
+                }
+            }
+        });
+    }
+    flush();
+
+    const auto pointOffset = p_geometryBytes;
+    p_geometryBytes += appendLittleEndian(p_geometryBlob, points);
+
+    std::string ans = "        <Topology TopologyType=\"Mixed\" NumberOfElements=\"" + std::to_string(cellCount) + "\">\n";
+    ans += "          " + dataItem(Storage::Int64, std::to_string(topologyCount), topologyOffset, p_geometryBlob);
+    ans += "        </Topology>\n";
+    ans += "        <Geometry GeometryType=\"XYZ\">\n";
+    ans += "          " + dataItem(Storage::Float64, std::to_string(pointCount) + " 3", pointOffset, p_geometryBlob);
+    ans += "        </Geometry>\n";
+    return ans;
+}
+
+std::string XDMFFile::dataItem(const XDMFFile::Storage storage,
+                               const std::string &dimensions,
+                               const XDMFFile::Offset offset,
+                               const TextFile &blob) {
+    std::string type;
+    switch (storage) {
+    case Storage::UInt8:    type = "UChar";   break;
+    case Storage::Int32:
+    case Storage::Int64:    type = "Int";     break;
+    case Storage::UInt64:   type = "UInt";    break;
+    case Storage::Float32:
+    case Storage::Float64:  type = "Float";   break;
+    }
+    return "<DataItem Format=\"Binary\" Endian=\"Little\" DataType=\"" + type + "\" Precision=\""
+            + std::to_string(NumberFormat::sizeOf(storage)) + "\" Dimensions=\"" + dimensions + "\" Seek=\""
+            + std::to_string(offset) + "\">" + quoted(blob.fullName(false)) + "</DataItem>\n";
+}
+
+} // namespace exporting
@@ -0,0 +1,114 @@
+//
+//  XDMFFile.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef XDMFFILE_H
+#define XDMFFILE_H
+
+#include "VTKFile.h"
+#include <map>
+#include <memory>
+
+/**
+ * The exporting namespace provides the means to handle exporting simulation data to files.
+ */
+namespace exporting {
+
+/**
+ * @brief The XDMFFile class provides the means to handle exporting the steps of a simulation to an XDMF (.xmf) file,
+ *        whose arrays are kept as raw little-endian blobs (i.e., <name>_geometry.bin and <name>_data.bin).
+ * @details Each step is a VTKFile (e.g., the files given by VTKFileSeries::next) whose sections' bodies are appended to
+ *          the blobs as they are, only their byte order is changed (see appendStep). The xmf file only holds the
+ *          temporal collection of the steps, referring to the arrays by their offset inside the blobs, and is kept
+ *          complete after each step.
+ *          The geometry of the steps sharing the same locked configuration (see VTKFileSeries::lockSharedConfiguration)
+ *          is written once, the later steps refer to the same part of the geometry blob.
+ * @note The class is not default constructable.
+ * @note The class is not copiable.
+ */
+class XDMFFile: public file_system::BaseFile
+{
+public:
+
+    using Size = std::size_t;
+
+    /**
+     * @brief The constructor.
+     * @note The files are created (overriding any existing one) by the first step.
+     * @param name The name of the file (the path to the file included).
+     * @param extension The extention of the file without the dot(.).
+     */
+    explicit XDMFFile(const std::string &name,
+                      const std::string &extension = "xmf");
+
+    /**
+     * @brief The constructor.
+     * @note The files are created (overriding any existing one) by the first step.
+     * @param path The directory path of the file.
+     * @param name The name of the file.
+     * @param extension The extention of the file without the dot(.).
+     */
+    explicit XDMFFile(const std::string &path,
+                      const std::string &name,
+                      const std::string &extension);
+
+    XDMFFile(const XDMFFile& other) = delete;
+    XDMFFile& operator =(const XDMFFile&) = delete;
+
+    /**
+     * @brief Gives the number of the steps appended so far.
+     */
+    Size stepCount() const;
+
+    /**
+     * @brief Appends the content of a vtk file as the next step.
+     * @param file The vtk file of the step, in the binary encoding.
+     * @param time The simulation time of the step.
+     * @param removeSections If true, removes the temp files of the vtk file's section bodies afterward.
+     * @throws If the vtk file is not in the binary encoding or writes the points directly.
+     * @throws If the size of the sections' content are not compatible.
+     * @throws If any of the cells has no XDMF counterpart (i.e., the triangle strips).
+     * @throws If the files could not be written.
+     */
+    void appendStep(VTKFile & file, const double time, bool removeSections = true);
+
+private:
+
+    using Offset = std::uint64_t;
+    using Storage = NumberFormat::Storage;
+
+    /**
+     * @brief Appends the points and the mixed topology of a vtk file to the geometry blob.
+     * @param file The vtk file.
+     * @return The <Topology> and <Geometry> tags of the appended geometry.
+     * @throws If any of the cells has no XDMF counterpart.
+     * @throws If a section's body could not be read.
+     */
+    std::string appendGeometry(const VTKFile & file);
+
+    /**
+     * @brief Gives the <DataItem> tag of an array of a blob.
+     * @param storage The storage type of the values.
+     * @param dimensions The dimensions of the array (e.g., "10 3").
+     * @param offset The offset of the array inside the blob.
+     * @param blob The blob.
+     */
+    static std::string dataItem(const Storage storage, const std::string & dimensions, const Offset offset, const TextFile & blob);
+
+    TextFile p_dataBlob;                                // The attributes of the steps.
+    TextFile p_geometryBlob;                            // The points and the topologies of the steps.
+    Offset p_dataBytes;                                 // The number of bytes of the data blob.
+    Offset p_geometryBytes;                             // The number of bytes of the geometry blob.
+    std::string p_geometry;                             // The <Topology> and <Geometry> tags of the last written geometry.
+    std::shared_ptr<VTKFile> p_geometrySource;          // The locked configuration of the last written geometry, if any.
+    Size p_stepCount;                                   // The number of the steps appended so far.
+
+};
+
+} // namespace exporting
+
+#endif // XDMFFILE_H
@@ -8,6 +8,8 @@
 
 #include "BaseFile.h"
 #include "FileRegistar.h"
+#include <algorithm>
+#include <cstdio>
 
 namespace exporting::file_system {
 
@@ -21,7 +23,7 @@ BaseFile::BaseFile(const std::string &name, const std::string &extension)
         return c == '.' || c == '!' || c == '@'|| c == '#'|| c == '$'
                 || c == '%' || c == '^' || c == '&' || c == '*' || c == '('
                 || c == ')' || c == '`' || c == '~' || c == '+' || c == '='
-                || c == '/' || c == '>' || c == '<' || c == ',';}));
+                || c == '/' || c == '>' || c == '<' || c == ',';}), p_extension.end());
 
     // If the file name is set to empty string change it to "un-named".
     if (p_name.compare("") == 0)
@@ -82,4 +84,28 @@ bool BaseFile::remove()
     return !static_cast<bool>(std::remove(fullName(true).c_str()));
 }
 
+bool BaseFile::insertBeforeTail(const std::string &text, const std::string &tail, const std::string &head, const bool startOver)
+{
+    auto & registar = FileRegistar::current();
+    const auto file = registar.open(fullName(true).c_str(), (startOver) ? "wb" : "r+b");
+    if (!file)
+        return false;
+
+    bool done = true;
+    if (startOver) {
+        done = std::fwrite(head.data(), 1, head.size(), file) == head.size();
+    } else {
+        // Only the tail is overwritten.
+        const auto tailSize = static_cast<long>(tail.size());
+        std::string end(tail.size(), '\0');
+        done = std::fseek(file, -tailSize, SEEK_END) == 0
+                && std::fread(end.data(), 1, end.size(), file) == end.size() && end == tail
+                && std::fseek(file, -tailSize, SEEK_END) == 0;
+    }
+    done = done && std::fwrite(text.data(), 1, text.size(), file) == text.size()
+            && std::fwrite(tail.data(), 1, tail.size(), file) == tail.size()
+            && std::fflush(file) == 0;
+    return registar.close(file) && done;
+}
+
 } // namespace file_system
@@ -81,6 +81,19 @@ public:
      */
     bool remove();
 
+protected:
+
+    /**
+     * @brief Writes a text in front of the tail the file ends with (e.g., the closing tags of an XML collection), so the
+     *        file stays complete after each write and the content before the tail is never rewritten.
+     * @param text The text.
+     * @param tail The tail.
+     * @param head The begining of the file, written before the text if the file is started over.
+     * @param startOver If true, overrides the file with the head, the text, and the tail.
+     * @return True if successful, false otherwise (e.g., the file does not end with the tail).
+     */
+    bool insertBeforeTail(const std::string & text, const std::string & tail, const std::string & head, const bool startOver);
+
 private:
 
    std::string p_extension;     // The extention of the file with out the dot(.).
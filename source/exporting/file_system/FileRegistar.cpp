@@ -7,6 +7,11 @@
 //
 
 #include "FileRegistar.h"
+#include <algorithm>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
 
 namespace exporting::file_system {
 
@@ -16,33 +21,141 @@ FileRegistar &FileRegistar::current() {
 }
 
 FileRegistar::Size FileRegistar::canOpen() const {
-    return maxAllowed() - p_files.size();
+    std::lock_guard<std::mutex> lock(p_mutex);
+    return p_maxAllowed - p_files.size();
 }
 
 std::FILE *FileRegistar::open(const char *filename, const char *mode){
-    while(!canOpen()){ /* Wait untill there is a place available. */ }
+    std::unique_lock<std::mutex> lock(p_mutex);
+    makeRoom(lock);
     const auto ptr = std::fopen(filename, mode);
-    p_files.insert(ptr);
+    if (ptr)
+        p_files.insert(ptr);
     return ptr;
 }
 
 bool FileRegistar::close(std::FILE *stream){
-    if (std::fclose(stream) == 0) {
-        p_files.erase(stream);
-        return true;
+    if (!stream)
+        return false;
+    bool closed;
+    {
+        std::lock_guard<std::mutex> lock(p_mutex);
+        p_files.erase(stream); // The stream is not usable after fclose, even if it fails.
+        closed = std::fclose(stream) == 0;
+    }
+    p_closed.notify_one();
+    return closed;
+}
+
+bool FileRegistar::open(const SingleFile &owner, const std::string &filename, const bool override) {
+    const auto file = open(filename.c_str(), (override) ? "w" : "a");
+    if (!file)
+        return false;
+    std::lock_guard<std::mutex> lock(p_mutex);
+    p_handles[&owner] = Handle{file, filename, 0, 0};
+    p_lru.push_back(&owner);
+    return true;
+}
+
+std::FILE *FileRegistar::acquire(const SingleFile &owner) {
+    std::unique_lock<std::mutex> lock(p_mutex);
+    const auto itr = p_handles.find(&owner);
+    if (itr == p_handles.end())
+        return nullptr;
+    itr->second.pins++; // Pinned before making room, so that it is not parked meanwhile.
+    if (!itr->second.file) {
+        makeRoom(lock);
+        auto & handle = p_handles.at(&owner);
+        handle.file = std::fopen(handle.filename.c_str(), "r+");
+        if (handle.file && std::fseek(handle.file, handle.offset, SEEK_SET) != 0) {
+            std::fclose(handle.file);
+            handle.file = nullptr;
+        }
+        if (!handle.file) {
+            handle.pins--;
+            return nullptr;
+        }
+        p_files.insert(handle.file);
+        p_lru.push_back(&owner);
+        return handle.file;
     }
-    return false;
+    p_lru.remove(&owner);
+    p_lru.push_back(&owner);
+    return itr->second.file;
+}
+
+void FileRegistar::release(const SingleFile &owner) {
+    {
+        std::lock_guard<std::mutex> lock(p_mutex);
+        const auto itr = p_handles.find(&owner);
+        if (itr == p_handles.end() || !itr->second.pins)
+            return;
+        itr->second.pins--;
+    }
+    p_closed.notify_one();
+}
+
+bool FileRegistar::close(const SingleFile &owner) {
+    std::FILE* file = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(p_mutex);
+        const auto itr = p_handles.find(&owner);
+        if (itr == p_handles.end())
+            return false;
+        file = itr->second.file;
+        p_handles.erase(itr);
+        p_lru.remove(&owner);
+    }
+    if (!file)
+        return true; // A parked file is already closed.
+    return close(file);
+}
+
+FileRegistar::Size FileRegistar::maxAllowed() const {
+    return p_maxAllowed;
 }
 
 FileRegistar::FileRegistar()
-    : p_files{}
+    : p_closed{}
+    , p_files{}
+    , p_handles{}
+    , p_lru{}
+    , p_maxAllowed{computeMaxAllowed()}
+    , p_mutex{}
 {}
 
-FileRegistar::FileRegistar(const FileRegistar &other) = default;
-FileRegistar& FileRegistar::operator =(FileRegistar&) = default;
-
-constexpr FileRegistar::Size FileRegistar::maxAllowed() const {
+FileRegistar::Size FileRegistar::computeMaxAllowed() {
+#if defined(__unix__) || defined(__APPLE__)
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY) {
+        // Leaves a quarter of the descriptors for the rest of the process (e.g., the standard streams, sockets).
+        const auto allowed = static_cast<Size>(limit.rlim_cur) / 4 * 3;
+        return (allowed > FOPEN_MAX) ? allowed : FOPEN_MAX;
+    }
+#endif
     return FOPEN_MAX;
 }
 
+void FileRegistar::makeRoom(std::unique_lock<std::mutex> &lock) {
+    while (p_files.size() >= p_maxAllowed) {
+        const auto idle = std::find_if(p_lru.begin(), p_lru.end(), [this](const SingleFile* owner) {
+            return !p_handles.at(owner).pins;
+        });
+        if (idle != p_lru.end()) {
+            park(p_handles.at(*idle));
+            p_lru.erase(idle);
+        } else {
+            p_closed.wait(lock);
+        }
+    }
+}
+
+void FileRegistar::park(FileRegistar::Handle &handle) {
+    std::fflush(handle.file);
+    handle.offset = std::ftell(handle.file);
+    p_files.erase(handle.file);
+    std::fclose(handle.file);
+    handle.file = nullptr;
+}
+
 } // namespace exporting::file_system
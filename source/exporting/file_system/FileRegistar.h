@@ -9,18 +9,29 @@
 #ifndef FILEREGISTAR_H
 #define FILEREGISTAR_H
 
+#include <condition_variable>
 #include <cstdio>
+#include <list>
+#include <map>
+#include <mutex>
 #include <set>
+#include <string>
 
 /**
  * The file_system namespace provides the means to handle files on the operating system file system.
  */
 namespace exporting::file_system {
 
+class SingleFile;
+
 /**
  * @brief The FileRegistar class.
  * @details The file system, due to security reasons, does not allow the software to open files indefinitely.
  *          This class is a singleton that counts the number of opened files and opens a new one if allowed by the operating system.
+ *          The registar is thread safe, opening a file blocks the caller until another thread closes one if no place is left.
+ * @details The limit is taken from the operating system (i.e., RLIMIT_NOFILE), with a margin for the rest of the process.
+ *          The files of the SingleFile objects are kept in a pool: once the limit is reached, the least recently used idle
+ *          one is parked (i.e., closed while its offset is kept) and reopened at the same offset once it is acquired again.
  */
 class FileRegistar
 {
@@ -40,6 +51,7 @@ public:
 
     /**
      * @brief Opens a file and returns the pointer to it.
+     * @note Blocks the caller until there is a place available.
      * @param filename The name of the file
      * @param mode The access mode same as std::fopen mode.
      */
@@ -52,8 +64,56 @@ public:
      */
     bool close(std::FILE* stream);
 
+    /**
+     * @brief Opens the file of a SingleFile as a pooled file, which can be parked while it is not acquired.
+     * @note Blocks the caller until there is a place available.
+     * @param owner The SingleFile that owns the file.
+     * @param filename The name of the file.
+     * @param override If true, it will override the file incase it exsists, and appends if false.
+     * @return True, if successful, false otherwise.
+     */
+    bool open(const SingleFile & owner, const std::string & filename, const bool override);
+
+    /**
+     * @brief Pins the pooled file of a SingleFile (i.e., it will not be parked) and reopens it if it is parked.
+     * @note Each acquire should be followed by a release, the calls can be nested.
+     * @param owner The SingleFile that owns the file.
+     * @return The pointer to the file, nullptr if the file is not opened or could not be reopened.
+     */
+    std::FILE* acquire(const SingleFile & owner);
+
+    /**
+     * @brief Unpins the pooled file of a SingleFile, so that it can be parked if a place is needed.
+     * @param owner The SingleFile that owns the file.
+     */
+    void release(const SingleFile & owner);
+
+    /**
+     * @brief Closes the pooled file of a SingleFile.
+     * @param owner The SingleFile that owns the file.
+     * @return True, if successful, false otherwise.
+     */
+    bool close(const SingleFile & owner);
+
+    /**
+     * @brief Gives the maximum possible open files allowed by the operating system.
+     */
+    Size maxAllowed() const;
+
 private:
 
+    /**
+     * @brief The pooled file of a SingleFile.
+     */
+    struct Handle {
+        std::FILE* file;            // The file pointer, nullptr while it is parked.
+        std::string filename;       // The name of the file to reopen.
+        long offset;                // The offset of the file, kept while it is parked.
+        Size pins;                  // The number of the (nested) acquires.
+    };
+
+    using Handles = std::map<const SingleFile*, Handle>;
+
     /**
      * @brief Constroctor.
      * @note This is private since the file registar is a Singleton.
@@ -62,24 +122,39 @@ private:
 
     /**
      * @brief Copy Constroctor.
-     * @note This is private since copying file registar should only be handled here;
-     *        otherwise, the file registar will not be a Singleton.
+     * @note This is deleted since copying the file registar would break the Singleton.
      */
-    FileRegistar(const FileRegistar& other);
+    FileRegistar(const FileRegistar& other) = delete;
 
     /**
      * @brief Assignment Operation.
-     * @note This is private since assiging file registar systems should only be handled here;
-     *        otherwise, the file registar will not be a Singleton.
+     * @note This is deleted since assiging the file registar would break the Singleton.
+     */
+    FileRegistar& operator =(FileRegistar&) = delete;
+
+    /**
+     * @brief Computes the maximum possible open files allowed by the operating system.
      */
-    FileRegistar& operator =(FileRegistar&);
+    static Size computeMaxAllowed();
 
     /**
-     * @brief Gives the maximum possible open files allowed by the operating system.\
+     * @brief Waits until there is a place to open a file, parks the least recently used idle pooled file if needed.
+     * @param lock The lock on the mutex of the registar.
      */
-    constexpr Size maxAllowed() const;
+    void makeRoom(std::unique_lock<std::mutex> & lock);
 
-    FilePtrs p_files; // The files that are opens with this registar.
+    /**
+     * @brief Closes a pooled file but keeps its offset to reopen it later.
+     * @param handle The pooled file.
+     */
+    void park(Handle & handle);
+
+    std::condition_variable p_closed;   // Notifies the threads waiting for a place to open a file.
+    FilePtrs p_files;                   // The files that are opens with this registar.
+    Handles p_handles;                  // The pooled files of the SingleFile objects.
+    std::list<const SingleFile*> p_lru; // The owners of the open pooled files, the least recently used first.
+    const Size p_maxAllowed;            // The maximum possible open files.
+    mutable std::mutex p_mutex;         // Guards the opened files.
 
 };
 
@@ -0,0 +1,97 @@
+//
+//  IOQueue.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "IOQueue.h"
+
+namespace exporting::file_system {
+
+IOQueue &IOQueue::current() {
+    static IOQueue singleQueue;
+    return singleQueue;
+}
+
+IOQueue::~IOQueue() {
+    {
+        std::lock_guard<std::mutex> lock(p_mutex);
+        p_stop = true;
+    }
+    p_condition.notify_all();
+    if (p_thread.joinable())
+        p_thread.join();
+}
+
+IOQueue::Size IOQueue::capacity() const {
+    std::lock_guard<std::mutex> lock(p_mutex);
+    return p_capacity;
+}
+
+IOQueue::Size IOQueue::inFlight() const {
+    std::lock_guard<std::mutex> lock(p_mutex);
+    return p_inFlight;
+}
+
+void IOQueue::setCapacity(const IOQueue::Size capacity) {
+    {
+        std::lock_guard<std::mutex> lock(p_mutex);
+        p_capacity = (capacity) ? capacity : 1;
+    }
+    p_condition.notify_all();
+}
+
+std::future<void> IOQueue::submit(IOQueue::Task task) {
+    std::packaged_task<void()> packagedTask(std::move(task));
+    auto ans = packagedTask.get_future();
+    {
+        std::unique_lock<std::mutex> lock(p_mutex);
+        p_condition.wait(lock, [this]{ return p_inFlight < p_capacity; });
+        p_tasks.emplace_back(std::move(packagedTask));
+        p_inFlight++;
+        if (!p_thread.joinable())
+            p_thread = std::thread(&IOQueue::run, this);
+    }
+    p_condition.notify_all();
+    return ans;
+}
+
+void IOQueue::wait() {
+    std::unique_lock<std::mutex> lock(p_mutex);
+    p_condition.wait(lock, [this]{ return p_inFlight == 0; });
+}
+
+IOQueue::IOQueue()
+    : p_capacity{defaultCapacity}
+    , p_mutex{}
+    , p_condition{}
+    , p_inFlight{0}
+    , p_stop{false}
+    , p_tasks{}
+    , p_thread{}
+{
+}
+
+void IOQueue::run() {
+    while (true) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(p_mutex);
+            p_condition.wait(lock, [this]{ return p_stop || !p_tasks.empty(); });
+            if (p_tasks.empty())
+                return;
+            task = std::move(p_tasks.front());
+            p_tasks.pop_front();
+        }
+        task(); // The exceptions are stored in the future of the task.
+        {
+            std::lock_guard<std::mutex> lock(p_mutex);
+            p_inFlight--;
+        }
+        p_condition.notify_all();
+    }
+}
+
+} // namespace exporting::file_system
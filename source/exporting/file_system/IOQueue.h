@@ -0,0 +1,106 @@
+//
+//  IOQueue.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef IOQUEUE_H
+#define IOQUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+/**
+ * The file_system namespace provides the means to handle files on the operating system file system.
+ */
+namespace exporting::file_system {
+
+/**
+ * @brief The IOQueue class provides a background thread that runs the file system tasks (e.g., assembling files) in order.
+ * @details This class is a singleton, the tasks are run one after the other on a single thread so that they do not
+ *          compete for the disk. The number of tasks in flight (queued or running) is capped; submitting more tasks
+ *          blocks the caller until a task is done (i.e., backpressure).
+ */
+class IOQueue
+{
+public:
+    using Size = std::size_t;
+    using Task = std::function<void()>;
+
+    static constexpr Size defaultCapacity = 2; // The default number of tasks allowed to be in flight.
+
+    /**
+     * @brief Provides the current IOQueue.
+     */
+    static IOQueue& current();
+
+    /**
+     * @brief The deconstructor.
+     * @note Runs the remaining tasks before stoping the background thread.
+     */
+    ~IOQueue();
+
+    /**
+     * @brief Gives the maximum number of tasks in flight (queued or running).
+     */
+    Size capacity() const;
+
+    /**
+     * @brief Gives the number of tasks in flight (queued or running).
+     */
+    Size inFlight() const;
+
+    /**
+     * @brief Sets the maximum number of tasks in flight (queued or running).
+     * @param capacity The number of tasks, at least one.
+     */
+    void setCapacity(const Size capacity);
+
+    /**
+     * @brief Submits a task to the background thread.
+     * @note Blocks the caller while the capacity is reached.
+     * @param task The task.
+     * @return The future that becomes ready (or holds the exception of the task) once the task is done.
+     */
+    std::future<void> submit(Task task);
+
+    /**
+     * @brief Blocks the caller until all the submitted tasks are done.
+     */
+    void wait();
+
+private:
+
+    /**
+     * @brief Constroctor.
+     * @note This is private since the io queue is a Singleton.
+     */
+    IOQueue();
+
+    IOQueue(const IOQueue& other) = delete;
+    IOQueue& operator =(const IOQueue&) = delete;
+
+    /**
+     * @brief Runs the tasks on the background thread until the queue is stoped.
+     */
+    void run();
+
+    Size p_capacity;                                // The maximum number of tasks in flight.
+    mutable std::mutex p_mutex;                     // Guards the queue.
+    std::condition_variable p_condition;            // Notifies the queue changes.
+    Size p_inFlight;                                // The number of tasks queued or running.
+    bool p_stop;                                    // Whether the background thread should stop or not.
+    std::deque<std::packaged_task<void()> > p_tasks;// The queued tasks.
+    std::thread p_thread;                           // The background thread.
+
+};
+
+} // namespace exporting::file_system
+
+#endif // IOQUEUE_H
@@ -0,0 +1,130 @@
+//
+//  RingBuffer.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+/**
+ * The file_system namespace provides the means to handle files on the operating system file system.
+ */
+namespace exporting::file_system {
+
+/**
+ * @brief The RingBuffer class provides a bounded lock-free queue with many producers and a single consumer.
+ * @details Each slot carries a sequence number that tells whether the slot is free for the producer of a position or
+ *          filled for the consumer of it (i.e., the bounded queue of Dmitry Vyukov), so neither side takes a lock.
+ * @note Only one thread should pop at a time.
+ * @tparam T The type of the values, should be default constructable and copy assignable.
+ */
+template<typename T>
+class RingBuffer
+{
+public:
+
+    using Size = std::size_t;
+
+    /**
+     * @brief The constructor.
+     * @param capacity The number of the slots, rounded up to a power of two.
+     */
+    explicit RingBuffer(const Size capacity)
+        : p_mask{roundUp(capacity) - 1}
+        , p_slots{std::make_unique<Slot[]>(p_mask + 1)}
+        , p_head{0}
+        , p_tail{0}
+    {
+        for (Size i = 0; i <= p_mask; i++)
+            p_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    RingBuffer(const RingBuffer& other) = delete;
+    RingBuffer& operator =(const RingBuffer&) = delete;
+
+    /**
+     * @brief Gives the number of the slots.
+     */
+    Size capacity() const {
+        return p_mask + 1;
+    }
+
+    /**
+     * @brief Pushes a value, if there is a free slot.
+     * @note Can be called from many threads at once.
+     * @param value The value.
+     * @return True if the value is pushed, false if the buffer is full.
+     */
+    bool tryPush(const T & value) {
+        auto position = p_head.load(std::memory_order_relaxed);
+        while (true) {
+            auto & slot = p_slots[position & p_mask];
+            const auto sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence == position) {
+                if (p_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot.value = value;
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (sequence < position) {
+                return false; // The slot is not consumed since the last round.
+            } else {
+                position = p_head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Pops the oldest value, if any.
+     * @note Should only be called from one thread at a time.
+     * @param value Receives the value.
+     * @return True if a value is poped, false if the buffer is empty.
+     */
+    bool tryPop(T & value) {
+        const auto position = p_tail.load(std::memory_order_relaxed);
+        auto & slot = p_slots[position & p_mask];
+        if (slot.sequence.load(std::memory_order_acquire) != position + 1)
+            return false;
+        value = slot.value;
+        slot.sequence.store(position + p_mask + 1, std::memory_order_release);
+        p_tail.store(position + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+private:
+
+    /**
+     * @brief The Slot struct holds a value and the position it is filled for (plus one) or free for.
+     */
+    struct Slot {
+        std::atomic<Size> sequence;
+        T value;
+    };
+
+    /**
+     * @brief Gives the smallest power of two that is not less than the number (at least 2).
+     */
+    static Size roundUp(const Size number) {
+        Size ans = 2;
+        while (ans < number)
+            ans <<= 1;
+        return ans;
+    }
+
+    const Size p_mask;                      // The number of the slots minus one.
+    std::unique_ptr<Slot[]> p_slots;        // The slots.
+    alignas(64) std::atomic<Size> p_head;   // The next position to push to.
+    alignas(64) std::atomic<Size> p_tail;   // The next position to pop from.
+
+};
+
+} // namespace exporting::file_system
+
+#endif // RINGBUFFER_H
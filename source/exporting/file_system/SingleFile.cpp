@@ -8,12 +8,20 @@
 
 #include "FileRegistar.h"
 #include "SingleFile.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 
 namespace exporting::file_system {
 
 SingleFile::SingleFile(const std::string &name, const std::string &extension)
     : BaseFile(name, extension)
+    , p_buffer{}
     , p_file{nullptr}
+    , p_opened{false}
+    , p_resident{false}
+    , p_spilled{false}
+    , p_spillThreshold{bufferSize}
 {
 }
 
@@ -29,37 +37,97 @@ SingleFile::~SingleFile()
     close();
 }
 
+const SingleFile::Buffer &SingleFile::buffer() const
+{
+    return p_buffer;
+}
+
 bool SingleFile::isOpen() const
 {
-    return static_cast<bool>(p_file);
+    return p_opened;
+}
+
+bool SingleFile::isSpilled() const
+{
+    return p_spilled;
+}
+
+bool SingleFile::isMemoryResident() const
+{
+    return p_resident;
 }
 
 bool SingleFile::save() {
-    if (isOpen()) {
-        std::fflush(p_file);
-        return true;
-    }
-    return false;
+    if (!isOpen())
+        open(false);
+    if (!flushBuffer() || !acquire())
+        return false;
+    const auto flushed = std::fflush(p_file) == 0;
+    release();
+    return flushed;
 }
 
 void SingleFile::close()
 {
+    if (!p_buffer.empty() && (p_spilled || !p_resident))
+        flushBuffer();
     if(isOpen()) {
-        std::fflush(p_file);
-        FileRegistar::current().close(p_file);
+        FileRegistar::current().close(*this);
         p_file = nullptr;
+        p_opened = false;
     }
 }
 
 void SingleFile::open(const bool override)
 {
-    const auto option = (override)? "w" : "a";
-    p_file = FileRegistar::current().open(fullName(true).c_str(), option);
+    if (isOpen()) {
+        FileRegistar::current().close(*this);
+        p_file = nullptr;
+    }
+    p_opened = FileRegistar::current().open(*this, fullName(true), override);
+    if (p_opened)
+        p_spilled = true; // The file holds the begining of the content from now on.
+}
+
+bool SingleFile::readContent(const SingleFile::Size blockBytes,
+                             const std::function<void (const char *, const SingleFile::Size)> &visit) const
+{
+    Buffer block(blockBytes);
+    Size filled = 0;
+    const auto feed = [&](const char * bytes, Size size) {
+        while (size) {
+            const auto part = std::min(size, block.size() - filled);
+            std::memcpy(block.data() + filled, bytes, part);
+            filled += part;
+            bytes += part;
+            size -= part;
+            if (filled == block.size()) {
+                visit(block.data(), filled);
+                filled = 0;
+            }
+        }
+    };
+
+    if (p_spilled) {
+        auto file = FileRegistar::current().open(fullName(true).c_str(), "rb");
+        if (!file)
+            return false;
+        char chunk[bufferSize];
+        while (const auto count = std::fread(chunk, 1, sizeof(chunk), file))
+            feed(chunk, count);
+        FileRegistar::current().close(file);
+    }
+    feed(p_buffer.data(), p_buffer.size());
+    if (filled)
+        visit(block.data(), filled);
+    return true;
 }
 
 bool SingleFile::cleanContent() noexcept
 {
     try {
+        p_buffer.clear();
+        p_spilled = false;
         close();
         open(true);
         close();
@@ -71,13 +139,65 @@ bool SingleFile::cleanContent() noexcept
 
 bool SingleFile::remove()
 {
+    p_buffer.clear();
     close();
-    return BaseFile::remove();
+    const auto spilled = p_spilled;
+    p_spilled = false;
+    return BaseFile::remove() || !spilled;
+}
+
+void SingleFile::setMemoryResident(const bool resident)
+{
+    p_resident = resident;
+}
+
+void SingleFile::setSpillThreshold(const SingleFile::Size threshold)
+{
+    p_spillThreshold = threshold;
+}
+
+SingleFile::Size SingleFile::spillThreshold() const
+{
+    return p_spillThreshold;
 }
 
 const SingleFile::file_ptr &SingleFile::filePtr() const {
     return p_file;
 }
 
+SingleFile::file_ptr SingleFile::acquire() {
+    p_file = FileRegistar::current().acquire(*this);
+    return p_file;
+}
+
+void SingleFile::release() {
+    FileRegistar::current().release(*this);
+}
+
+bool SingleFile::flushBuffer() {
+    if (p_buffer.empty())
+        return true;
+    if (!isOpen())
+        open(false);
+    if (!acquire())
+        return false;
+    const auto written = std::fwrite(p_buffer.data(), sizeof(char), p_buffer.size(), p_file);
+    release();
+    const auto successful = written == p_buffer.size();
+    p_buffer.clear();
+    p_spilled = true;
+    return successful;
+}
+
+SingleFile::Size SingleFile::write(const char *data, const Size size) {
+    const auto limit = (p_spilled) ? bufferSize : p_spillThreshold;
+    if (p_buffer.capacity() < std::min(limit, bufferSize))
+        p_buffer.reserve(std::min(limit, bufferSize));
+    p_buffer.insert(p_buffer.end(), data, data + size);
+    if (p_buffer.size() >= limit)
+        flushBuffer();
+    return size;
+}
+
 } // namespace file_system
 
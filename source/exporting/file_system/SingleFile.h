@@ -10,6 +10,8 @@
 #define SINGLEFILE_H
 
 #include "BaseFile.h"
+#include <functional>
+#include <vector>
 
 /**
  * The file_system namespace provides the means to handle files on the operating system file system.
@@ -26,7 +28,11 @@ class SingleFile: public BaseFile
 {
 public:
 
+    using Buffer = std::vector<char>;
+    using Size = std::size_t;
+
     static constexpr auto seperator = std::filesystem::path::preferred_separator;
+    static constexpr Size bufferSize = 1 << 16; // The size of the output buffer before it is written to the file.
 
     /**
      * @brief The constructor.
@@ -51,13 +57,33 @@ public:
      */
      ~SingleFile();
 
+    SingleFile(const SingleFile& other) = delete;
+    SingleFile& operator =(const SingleFile&) = delete;
+
+    /**
+     * @brief Gives the content that is not written to the file yet.
+     */
+    const Buffer & buffer() const;
+
     /**
      * @brief Gives true if the file is open, false otherwise.
      */
     bool isOpen() const;
 
+    /**
+     * @brief Whether the file is part of the content or not (i.e., it is opened or written at least once), otherwise
+     *        the content is only kept in memory.
+     */
+    bool isSpilled() const;
+
+    /**
+     * @brief Whether the content below the spill threshold is only kept in memory on close (see setMemoryResident) or not.
+     */
+    bool isMemoryResident() const;
+
     /**
      * @brief Closes the file and removes the pointer to it.
+     * @note The output buffer will be written to the file beforehand, unless the file is memory resident and not spilled.
      */
     void close();
 
@@ -68,6 +94,15 @@ public:
      */
     void open(const bool override);
 
+    /**
+     * @brief Reads the content of the file (i.e., its spilled part, then its buffer) in blocks.
+     * @note The file should be saved beforehand, if its content is spilled to the file system.
+     * @param blockBytes The number of bytes of each block, only the last block can be smaller.
+     * @param visit The function that receives each block (i.e., the pointer to the bytes and their number).
+     * @return True if successful, false otherwise (e.g., the spilled part could not be opened).
+     */
+    bool readContent(const Size blockBytes, const std::function<void(const char *, const Size)> & visit) const;
+
     /**
      * @brief Removes the content of the file.
      * @note The fill will be closed afterward.
@@ -77,25 +112,86 @@ public:
 
     /**
      * @brief Removes the file without move it to bin/trash directory.
+     * @note The content that was only kept in memory counts as removed, even if the file does not exist.
      * @return True if successful, false otherwise.
      */
     bool remove();
 
     /**
-     * @brief Flushes the file but keeps it open!
+     * @brief Flushes the output buffer and the file but keeps it open!
+     * @note The file is opened (to append) if it is not open, even if the content is below the spill threshold.
      * @return True if successful, false otherwise.
      */
     bool save();
 
+    /**
+     * @brief Sets whether the content below the spill threshold is only kept in memory on close (and destruction) or
+     *        written to the file.
+     * @note Meant for the temp files read back by their owner (e.g., the sections' bodies, see TextFile::appendContent),
+     *       they are never created as long as their content is below the spill threshold.
+     * @param resident If true, the content below the spill threshold is not written to the file on close.
+     */
+    void setMemoryResident(const bool resident);
+
+    /**
+     * @brief Sets the number of chars kept in memory before the file is written for the first time.
+     * @note Once the threshold is exceeded the content is spilled to the file and the bufferSize is used afterward.
+     * @note The file is not created (nor opened) as long as the content is below the threshold.
+     * @param threshold The number of chars, the default is the bufferSize.
+     */
+    void setSpillThreshold(const Size threshold);
+
+    /**
+     * @brief Gives the number of chars kept in memory before the file is written for the first time.
+     */
+    Size spillThreshold() const;
+
 protected:
 
     using file_ptr = FILE *;
 
+    /**
+     * @brief Gives the file pointer.
+     * @note The pointer is only valid between acquire() and release(), the file can be parked by the FileRegistar otherwise.
+     */
     const file_ptr & filePtr() const;
 
+    /**
+     * @brief Pins the file (i.e., the FileRegistar will not park it) and reopens it if it is parked.
+     * @note Each successful acquire should be followed by a release, the calls can be nested.
+     * @return The pointer to the file, nullptr if the file is not open or could not be reopened.
+     */
+    file_ptr acquire();
+
+    /**
+     * @brief Unpins the file, so that the FileRegistar can park it if a place is needed for another file.
+     */
+    void release();
+
+    /**
+     * @brief Writes the content of the output buffer to the file.
+     * @note The file will be opened (to append) if it is not open.
+     * @return True if successful, false otherwise.
+     */
+    bool flushBuffer();
+
+    /**
+     * @brief Appends chars to the output buffer of the file.
+     * @note The output buffer will be written to the file once it exceeds the bufferSize (or the spill threshold, the first time).
+     * @param data The begining of the chars.
+     * @param size The number of the chars.
+     * @return The number of chars added to the buffer.
+     */
+    Size write(const char * data, const Size size);
+
 private:
 
-   file_ptr p_file;     // The file pointer.
+   Buffer p_buffer;         // The output buffer, holds the chars that are not written to the file yet.
+   file_ptr p_file;         // The file pointer, valid while it is acquired.
+   bool p_opened;           // Whether the file is opened (it might be parked by the FileRegistar meanwhile).
+   bool p_resident;         // Whether the content below the spill threshold is only kept in memory on close.
+   bool p_spilled;          // Whether the file is part of the content (i.e., opened or written at least once).
+   Size p_spillThreshold;   // The number of chars kept in memory before the first write to the file.
 
 };
 
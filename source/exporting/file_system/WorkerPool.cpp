@@ -0,0 +1,136 @@
+//
+//  WorkerPool.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "WorkerPool.h"
+
+namespace exporting::file_system {
+
+WorkerPool &WorkerPool::current() {
+    static WorkerPool singlePool;
+    return singlePool;
+}
+
+WorkerPool::~WorkerPool() {
+    stop();
+}
+
+WorkerPool::Size WorkerPool::threadCount() const {
+    std::lock_guard<std::mutex> lock(p_mutex);
+    return p_threadCount;
+}
+
+void WorkerPool::setThreadCount(const WorkerPool::Size count) {
+    stop();
+    std::lock_guard<std::mutex> lock(p_mutex);
+    p_threadCount = (count) ? count : 1;
+    p_stop = false;
+}
+
+void WorkerPool::run(const WorkerPool::Size count, const WorkerPool::Task &task) {
+    if (count == 0)
+        return;
+    if (count == 1 || threadCount() == 1 || p_busy.exchange(true)) {
+        for (Size part = 0; part < count; part++)
+            task(part);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(p_mutex);
+        while (p_threads.size() + 1 < p_threadCount)
+            p_threads.emplace_back(&WorkerPool::work, this);
+        p_task = &task;
+        p_count = count;
+        p_next = 0;
+        p_pending = count;
+        p_exception = nullptr;
+        p_generation++;
+    }
+    p_condition.notify_all();
+    drain(false);
+
+    std::exception_ptr exception;
+    {
+        std::unique_lock<std::mutex> lock(p_mutex);
+        p_done.wait(lock, [this]{ return !p_pending && !p_active; });
+        p_task = nullptr;
+        exception = p_exception;
+    }
+    p_busy = false;
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+WorkerPool::WorkerPool()
+    : p_busy{false}
+    , p_mutex{}
+    , p_condition{}
+    , p_done{}
+    , p_threadCount{std::max(1u, std::thread::hardware_concurrency())}
+    , p_threads{}
+    , p_stop{false}
+    , p_generation{0}
+    , p_task{nullptr}
+    , p_count{0}
+    , p_next{0}
+    , p_pending{0}
+    , p_active{0}
+    , p_exception{}
+{
+}
+
+void WorkerPool::drain(const bool worker) {
+    Size done = 0;
+    for (auto part = p_next++; part < p_count; part = p_next++) {
+        try {
+            (*p_task)(part);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(p_mutex);
+            if (!p_exception)
+                p_exception = std::current_exception();
+        }
+        done++;
+    }
+
+    std::lock_guard<std::mutex> lock(p_mutex);
+    p_pending -= done;
+    if (worker)
+        p_active--;
+    if (!p_pending && !p_active)
+        p_done.notify_all();
+}
+
+void WorkerPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(p_mutex);
+        p_stop = true;
+    }
+    p_condition.notify_all();
+    for (auto & thread : p_threads)
+        thread.join();
+    p_threads.clear();
+}
+
+void WorkerPool::work() {
+    std::unique_lock<std::mutex> lock(p_mutex);
+    auto generation = p_generation;
+    while (true) {
+        p_condition.wait(lock, [this, &generation]{ return p_stop || p_generation != generation; });
+        if (p_stop)
+            return;
+        generation = p_generation;
+        if (!p_task)
+            continue; // The job is already done.
+        p_active++;
+        lock.unlock();
+        drain(true);
+        lock.lock();
+    }
+}
+
+} // namespace exporting::file_system
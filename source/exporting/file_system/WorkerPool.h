@@ -0,0 +1,115 @@
+//
+//  WorkerPool.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * The file_system namespace provides the means to handle files on the operating system file system.
+ */
+namespace exporting::file_system {
+
+/**
+ * @brief The WorkerPool class provides a set of threads that share the independent parts of a job (e.g., copying the
+ *        sections of a file at their offsets).
+ * @details This class is a singleton, the threads are started on the first parallel job and the caller of a job works on
+ *          it as well. A job started while another one is running (e.g., from inside a part, or from the IOQueue) is run
+ *          on its caller alone, so the jobs never wait for each other.
+ */
+class WorkerPool
+{
+public:
+    using Size = std::size_t;
+    using Task = std::function<void(const Size)>;
+
+    /**
+     * @brief Provides the current WorkerPool.
+     */
+    static WorkerPool& current();
+
+    /**
+     * @brief The deconstructor.
+     */
+    ~WorkerPool();
+
+    /**
+     * @brief Gives the number of threads working on a job (the caller included).
+     */
+    Size threadCount() const;
+
+    /**
+     * @brief Sets the number of threads working on a job (the caller included).
+     * @note Should not be called while a job is running.
+     * @param count The number of threads, one runs the jobs on their callers.
+     */
+    void setThreadCount(const Size count);
+
+    /**
+     * @brief Runs the parts of a job on the pool and blocks the caller until all of them are done.
+     * @param count The number of the parts.
+     * @param task The task, called once with each part index in [0, count).
+     * @throws The first exception thrown by the parts, once all of them are done.
+     */
+    void run(const Size count, const Task & task);
+
+private:
+
+    /**
+     * @brief Constroctor.
+     * @note This is private since the worker pool is a Singleton.
+     */
+    WorkerPool();
+
+    WorkerPool(const WorkerPool& other) = delete;
+    WorkerPool& operator =(const WorkerPool&) = delete;
+
+    /**
+     * @brief Runs the parts of the current job until none is left.
+     * @param worker Whether the caller is a thread of the pool or not.
+     */
+    void drain(const bool worker);
+
+    /**
+     * @brief Stops and joins the threads of the pool.
+     */
+    void stop();
+
+    /**
+     * @brief Waits for the jobs on a thread of the pool until the pool is stoped.
+     */
+    void work();
+
+    std::atomic<bool> p_busy;                   // Whether a job is running or not.
+    mutable std::mutex p_mutex;                 // Guards the job.
+    std::condition_variable p_condition;        // Notifies the threads about a new job (or stop).
+    std::condition_variable p_done;             // Notifies the caller that the job is done.
+    Size p_threadCount;                         // The number of threads working on a job (the caller included).
+    std::vector<std::thread> p_threads;         // The threads of the pool.
+    bool p_stop;                                // Whether the threads should stop or not.
+    Size p_generation;                          // The number of the jobs started so far.
+    const Task * p_task;                        // The task of the current job.
+    Size p_count;                               // The number of the parts of the current job.
+    std::atomic<Size> p_next;                   // The next part of the current job to run.
+    Size p_pending;                             // The number of the parts of the current job not done yet.
+    Size p_active;                              // The number of the threads of the pool running the current job.
+    std::exception_ptr p_exception;             // The first exception of the current job.
+
+};
+
+} // namespace exporting::file_system
+
+#endif // WORKERPOOL_H
@@ -7,6 +7,7 @@
 //
 
 #include "VTKAttributeSection.h"
+#include <algorithm>
 
 namespace exporting {
 
@@ -18,6 +19,7 @@ VTKAttributeSection::VTKAttributeSection(const std::string &name, const std::str
     , p_dataType{DataType::Double}
 {
     bodyPtr()->setSeperator(" ");
+    updateFormat();
 }
 
 VTKAttributeSection::VTKAttributeSection(const std::string &path, const std::string &name, const std::string &attributeName, const VTKAttributeSection::AttributeType attribute, const VTKAttributeSection::SourceType source)
@@ -32,7 +34,7 @@ const std::string VTKAttributeSection::filterAttributeName(const std::string &na
         return c == ' ' || c == '.' || c == '!' || c == '@'|| c == '#'|| c == '$'
                 || c == '%' || c == '^' || c == '&' || c == '*' || c == '('
                 || c == ')' || c == '`' || c == '~' || c == '+' || c == '='
-                || c == '/' || c == '>' || c == '<' || c == ',';}));
+                || c == '/' || c == '>' || c == '<' || c == ',';}), ans.end());
 
     // If the file name is set to empty string change it to "un-named".
     if (ans.compare("") == 0)
@@ -46,6 +48,39 @@ const std::string VTKAttributeSection::filterAttributeName(const std::string &na
     return ans;
 }
 
+std::vector<TextFile::Block> VTKAttributeSection::assemblyBlocks(const std::map<std::string, std::shared_ptr<VTKAttributeSection> > &sections,
+                                                                 const VTKAttributeSection::Size pointCount,
+                                                                 const VTKAttributeSection::Size cellCount) {
+    std::vector<TextFile::Block> ans;
+    std::string text; // The text waiting for the next block.
+    for (const auto sourceType : {SourceType::Point, SourceType::Cell}) {
+        bool headerPrinted = false;
+        for (const auto & attributeSection : sections) {
+            const auto & section = *attributeSection.second;
+            if (section.source() == sourceType) {
+                if(!headerPrinted) {
+                    text += (sourceType == SourceType::Point) ? "POINT_DATA " + std::to_string(pointCount)
+                                                              : "CELL_DATA " + std::to_string(cellCount);
+                    text += "\n";
+                    headerPrinted = true;
+                }
+
+                text += section.header() + "\n";
+                if (section.attributeType() == AttributeType::Scalar)
+                    text += "LOOKUP_TABLE default\n";
+
+                const auto lineEnd = section.encoding() == Encoding::Binary || section.body().columnCount() != 0;
+                ans.push_back(TextFile::Block{std::move(text), &section.body(), (lineEnd) ? "\n" : ""});
+                text.clear();
+            }
+            text += "\n";
+        }
+    }
+    if (!text.empty())
+        ans.push_back(TextFile::Block{std::move(text), nullptr, ""});
+    return ans;
+}
+
 std::string VTKAttributeSection::header() const {
     switch (p_type) {
     case AttributeType::Scalar:
@@ -66,6 +101,10 @@ VTKAttributeSection::AttributeType VTKAttributeSection::attributeType() const {
     return p_type;;
 }
 
+VTKAttributeSection::Size VTKAttributeSection::componentCount() const {
+    return cellPerType(p_type);
+}
+
 VTKAttributeSection::Size VTKAttributeSection::size() const {
     return body().cellCount() / cellPerType(p_type);
 }
@@ -117,6 +156,23 @@ const std::string VTKAttributeSection::to_string(VTKAttributeSection::DataType t
     throw std::range_error("The data type of the section is not known.");
 }
 
+void VTKAttributeSection::updateFormat() {
+    using Storage = NumberFormat::Storage;
+    const auto binary = encoding() == Encoding::Binary;
+    switch (p_dataType) {
+    case DataType::Int:
+        setFormat((binary) ? NumberFormat::binary(Storage::Int32) : NumberFormat::of<int>(false));
+        return;
+    case DataType::Float:
+        setFormat((binary) ? NumberFormat::binary(Storage::Float32) : NumberFormat::of<float>(true));
+        return;
+    case DataType::Double:
+        setFormat((binary) ? NumberFormat::binary(Storage::Float64) : NumberFormat::of<double>(true));
+        return;
+    }
+    throw std::range_error("The data type of the section is not known.");
+}
+
 std::ostream &operator <<(std::ostream &out, const VTKAttributeSection::AttributeType &type)
 {
     using Type = VTKAttributeSection::AttributeType;
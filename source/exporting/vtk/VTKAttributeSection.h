@@ -9,7 +9,11 @@
 #ifndef VTKATTRIBUTESECTION_H
 #define VTKATTRIBUTESECTION_H
 
+#include "../Span.h"
 #include "VTKSection.h"
+#include <algorithm>
+#include <map>
+#include <memory>
 #include <vector>
 
 /**
@@ -82,6 +86,18 @@ public:
      */
     static const std::string filterAttributeName(const std::string & name);
 
+    /**
+     * @brief Gives the blocks of the attributes part of a vtk file (i.e., its POINT_DATA and CELL_DATA parts).
+     * @note The blocks are independent, they can be written in parallel (see TextFile::appendBlocks).
+     * @param sections The attribute sections of the file, by their name.
+     * @param pointCount The number of the points of the file.
+     * @param cellCount The number of the cells of the file.
+     * @return The blocks, in order.
+     */
+    static std::vector<TextFile::Block> assemblyBlocks(const std::map<std::string, std::shared_ptr<VTKAttributeSection> > & sections,
+                                                       const Size pointCount,
+                                                       const Size cellCount);
+
     /**
      * @brief Gives the header of the points section.
      */
@@ -97,6 +113,11 @@ public:
      */
     AttributeType attributeType() const;
 
+    /**
+     * @brief Gives the number of values per attribute (i.e., 1, 3, or 9 for scalar, vector, or tensor).
+     */
+    Size componentCount() const;
+
     /**
      * @brief Gives the number of information inside the body.
      * @note The return value should be equal to the size of the point/cell section body.
@@ -119,16 +140,60 @@ public:
      */
     template<typename T>
     void appendAttribute(const std::vector<T> & values) {
+        appendAttribute(Span<const T>(values));
+    }
+
+    /**
+     * @brief Appendd values to the attribute section's body without copying them.
+     * @note The attribute values will be added based on the attribute type.
+     * @tparam The type of the information, the first call will set the attribute data type.
+     * @param values The values of the attribute.
+     * @throws If the size of the values is not sufficient to close (e.g., for vector attribute: size%3 != 0).
+     * @throws If the data type is changed form the privious added data type.
+     * @throws If the values could not be appended.
+     */
+    template<typename T>
+    void appendAttribute(Span<const T> values) {
         setAttributeDataType<T>();
-        if (values.size() % cellPerType(p_type) != 0)
+        const auto valuesPerType = cellPerType(p_type);
+        if (values.size() % valuesPerType != 0)
             throw std::logic_error("The imported attribute values are out of size.");
-        if (p_type == AttributeType::Tensor) {
-            for(unsigned int itr = 0; itr + 8 < values.size(); itr += 9) {
-                bodyPtr()->appendRow(values, p_dataType != DataType::Int);
-                bodyPtr()->nextRow();
-            }
-        } else {
-            bodyPtr()->appendRow(values, p_dataType != DataType::Int);
+        const auto rowSize = (p_type == AttributeType::Tensor) ? valuesPerType : 0;
+        if (bodyPtr()->appendCells(values.data(), values.size(), rowSize, format()) != values.size())
+            throw std::runtime_error("Could not append the attribute values to the file.");
+    }
+
+    /**
+     * @brief Appendd values embedded inside a larger array (e.g., the velocity of the particle structs) to the
+     *        attribute section's body without copying the array.
+     * @note The values of each attribute (i.e., 1, 3, or 9 for scalar, vector, or tensor) are read contiguously
+     *       from the begining of each element.
+     * @tparam The type of the information, the first call will set the attribute data type.
+     * @param values The strided view of the attributes.
+     * @throws If the data type is changed form the privious added data type.
+     * @throws If the values could not be appended.
+     */
+    template<typename T>
+    void appendAttribute(StridedSpan<const T> values) {
+        setAttributeDataType<T>();
+        constexpr Size blockSize = 1 << 12;
+        const auto valuesPerType = cellPerType(p_type);
+        const auto rowSize = (p_type == AttributeType::Tensor) ? valuesPerType : 0;
+        // The large inputs are gathered in larger blocks, so that the pool can format each block in parallel.
+        const auto threads = file_system::WorkerPool::current().threadCount();
+        const auto valuesPerBlock = (values.size() * valuesPerType > blockSize && threads > 1)
+                ? threads * CSVFile::parallelChunk : blockSize;
+        const auto perBlock = valuesPerBlock / valuesPerType;
+        const auto & body = bodyPtr();
+        std::remove_const_t<T> stackBlock[blockSize];
+        std::vector<std::remove_const_t<T> > heapBlock((valuesPerBlock > blockSize) ? valuesPerBlock : 0);
+        const auto block = (valuesPerBlock > blockSize) ? heapBlock.data() : stackBlock;
+        for (Size done = 0; done < values.size(); done += perBlock) {
+            const auto size = std::min<Size>(values.size() - done, perBlock) * valuesPerType;
+            for (Size i = 0; i < size; i += valuesPerType)
+                std::copy(values.at(done + i / valuesPerType), values.at(done + i / valuesPerType) + valuesPerType, block + i);
+            if (body->appendCells(block, size, rowSize, format()) != size)
+                throw std::runtime_error("Could not append the attribute values to the file.");
         }
     }
 
@@ -202,8 +267,14 @@ protected:
         if(static_cast<bool>(bodyPtr()->cellCount()) && oldType != p_dataType) {
             throw std::runtime_error("The body is not empty, the content type cannot be changed.");
         }
+        updateFormat();
     }
 
+    /**
+     * @brief Resolves the number format of the attributes for the data type and the current encoding.
+     */
+    virtual void updateFormat() override;
+
 private:
 
     std::string p_name;     // The name of the attribute.
@@ -7,7 +7,9 @@
 //
 
 #include "VTKCell.h"
+#include <limits>
 #include <numeric>
+#include <stdexcept>
 
 namespace exporting {
 
@@ -7,11 +7,14 @@
 //
 
 #include "VTKCellSection.h"
+#include <algorithm>
+#include <cstring>
 
 namespace exporting {
 
 VTKCellSection::VTKCellSection(const std::string &name)
     : VTKSection(name + "_" + VTKSection::to_string(Type::Cells), VTKSection::Type::Cells)
+    , p_indexStorage{Storage::Int32}
 {
     bodyPtr()->setSeperator(" ");
 }
@@ -33,4 +36,154 @@ VTKCellSection::Size VTKCellSection::pointCount() const {
     return body().cellCount() - cellCount();
 }
 
+VTKCellSection::Storage VTKCellSection::indexStorage() const {
+    return p_indexStorage;
+}
+
+void VTKCellSection::setIndexStorage(const VTKCellSection::Storage storage) {
+    if (storage != Storage::Int32 && storage != Storage::Int64)
+        throw std::range_error("The point indexes can only be stored as Int32 or Int64.");
+    if (storage == p_indexStorage)
+        return;
+    if (body().cellCount())
+        throw std::runtime_error("Cannot change the index storage of the section if the body is not empty.");
+    p_indexStorage = storage;
+    updateFormat();
+}
+
+void VTKCellSection::readBinary(const std::function<void (const std::int64_t *, const VTKCellSection::Size)> &visit) const {
+    if (!format().isBinary())
+        throw std::logic_error("Only the binary cell section can be read back.");
+    constexpr Size blockSize = 1 << 13;
+    std::int64_t values[blockSize];
+    const auto wide = format().storage() == Storage::Int64;
+    const auto width = (wide) ? sizeof(std::int64_t) : sizeof(std::int32_t);
+    const auto read = body().readContent(blockSize * width, [&](const char * bytes, const Size size) {
+        const auto count = size / width;
+        if (wide) {
+            std::memcpy(values, bytes, size);
+        } else {
+            std::int32_t narrow[blockSize];
+            std::memcpy(narrow, bytes, size);
+            if (ByteOrder::native() != ByteOrder::Endian::Big)
+                ByteOrder::swap(narrow, count);
+            std::copy(narrow, narrow + count, values);
+        }
+        if (wide && ByteOrder::native() != ByteOrder::Endian::Big)
+            ByteOrder::swap(values, count);
+        visit(values, count);
+    });
+    if (!read)
+        throw std::runtime_error("Could not open the cell section's body (" + body().fullName(true) + ").");
+}
+
+VTKCellSection::CellIndex VTKCellSection::appendCell(const VTKCellSection::CellType type,
+                                                     const VTKCellSection::PointIndex first,
+                                                     const VTKCellSection::Size count) {
+    if (count < Cell::minPoints(type))
+        throw std::range_error("The cell requires more point indexes.");
+    if (count > Cell::maxPoints(type))
+        throw  std::range_error("The cell requires less point indexes.");
+    if (count)
+        checkIndex(first + count - 1);
+
+    constexpr Size blockSize = 1 << 10;
+    const auto & body = bodyPtr();
+    PointIndex block[blockSize];
+    block[0] = count;
+    Size size = 1;
+    for (auto index = first; index < first + count; size = 0) {
+        for (; size < blockSize && index < first + count; size++)
+            block[size] = index++;
+        if (body->appendCells(block, size, 0, format()) != size)
+            throw std::runtime_error("Could not append the cell to the file.");
+    }
+    body->nextRow();
+    return body->rowIndex();
+}
+
+VTKCellSection::CellIndex VTKCellSection::appendCells(const VTKCellSection::CellType type,
+                                                      Span<const PointIndex> connectivity,
+                                                      VTKCellSection::Size pointsPerCell) {
+    if (!pointsPerCell) {
+        if (!Cell::hasFixedNumberOfPoints(type))
+            throw std::range_error("The number of points per cell is required for the cells without a fixed number of points.");
+        pointsPerCell = Cell::minPoints(type);
+    }
+    if (pointsPerCell < Cell::minPoints(type))
+        throw std::range_error("The cell requires more point indexes.");
+    if (pointsPerCell > Cell::maxPoints(type))
+        throw  std::range_error("The cell requires less point indexes.");
+    if (connectivity.size() % pointsPerCell)
+        throw std::range_error("The connectivity does not hold a whole number of cells.");
+    for (const auto index : connectivity)
+        checkIndex(index);
+
+    // Each row of the body is the number of points of the cell followed by its point indexes.
+    const auto & body = bodyPtr();
+    const Size rowSize = pointsPerCell + 1;
+    const Size cellsPerBlock = std::max<Size>(1, (1 << 13) / rowSize);
+    std::vector<PointIndex> block;
+    block.reserve(cellsPerBlock * rowSize);
+    for (auto cell = connectivity.begin(); cell != connectivity.end();) {
+        block.clear();
+        for (Size i = 0; i < cellsPerBlock && cell != connectivity.end(); i++, cell += pointsPerCell) {
+            block.emplace_back(pointsPerCell);
+            block.insert(block.end(), cell, cell + pointsPerCell);
+        }
+        if (body->appendCells(block.data(), block.size(), rowSize, format()) != block.size())
+            throw std::runtime_error("Could not append the cells to the file.");
+    }
+    return body->rowIndex();
+}
+
+VTKCellSection::CellIndex VTKCellSection::appendCells(Span<const VTKCellSection::CellType> types,
+                                                      Span<const PointIndex> offsets,
+                                                      Span<const PointIndex> connectivity) {
+    if (types.empty())
+        return cellCount();
+    if (offsets.size() != types.size() + 1)
+        throw std::range_error("The number of the offsets should be one more than the number of the cells.");
+    if (offsets[types.size()] > connectivity.size())
+        throw std::range_error("The offsets exceed the connectivity.");
+    for (Size i = 0; i < types.size(); i++) {
+        if (offsets[i + 1] < offsets[i])
+            throw std::range_error("The offsets should not decrease.");
+        const auto size = offsets[i + 1] - offsets[i];
+        if (size < Cell::minPoints(types[i]))
+            throw std::range_error("The cell requires more point indexes.");
+        if (size > Cell::maxPoints(types[i]))
+            throw  std::range_error("The cell requires less point indexes.");
+    }
+    for (auto index = offsets[0]; index < offsets[types.size()]; index++)
+        checkIndex(connectivity[index]);
+
+    // Each row of the body is the number of points of the cell followed by its point indexes.
+    constexpr Size blockSize = 1 << 13;
+    const auto & body = bodyPtr();
+    std::vector<PointIndex> block;
+    std::vector<CSVFile::Column> rowSizes;
+    block.reserve(blockSize);
+    for (Size i = 0; i < types.size();) {
+        block.clear();
+        rowSizes.clear();
+        for (; i < types.size() && block.size() < blockSize; i++) {
+            const auto size = offsets[i + 1] - offsets[i];
+            block.emplace_back(size);
+            block.insert(block.end(), connectivity.begin() + offsets[i], connectivity.begin() + offsets[i + 1]);
+            rowSizes.emplace_back(size + 1);
+        }
+        if (body->appendCells(block.data(), rowSizes, format()) != block.size())
+            throw std::runtime_error("Could not append the cells to the file.");
+    }
+    return body->rowIndex();
+}
+
+void VTKCellSection::updateFormat() {
+    if (encoding() == Encoding::Binary)
+        setFormat(NumberFormat::binary(p_indexStorage));
+    else
+        VTKSection::updateFormat();
+}
+
 } // namespace exporting
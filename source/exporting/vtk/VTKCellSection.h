@@ -9,8 +9,12 @@
 #ifndef VTKCELLSECTION_H
 #define VTKCELLSECTION_H
 
+#include "../Span.h"
 #include "VTKCell.h"
 #include "VTKSection.h"
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <vector>
 
 /**
@@ -28,7 +32,9 @@ public:
     using Cell = VTKCell;
     using CellIndex = unsigned long;
     using CellType = VTKCell::Type;
+    using PointIndex = unsigned long;
     using Size = unsigned long;
+    using Storage = NumberFormat::Storage;
 
     /**
      * @brief The constructor.
@@ -58,6 +64,28 @@ public:
      */
     Size pointCount() const;
 
+    /**
+     * @brief Gives the type the point indexes are stored as in the binary encoding (i.e., Int32 or Int64).
+     */
+    Storage indexStorage() const;
+
+    /**
+     * @brief Sets the type the point indexes are stored as in the binary encoding.
+     * @note The legacy vtk files only read the Int32 indexes, the Int64 is meant for the vtu files.
+     * @param storage The type of the indexes (i.e., Int32 or Int64).
+     * @throws If the storage is neither Int32 nor Int64.
+     * @throws If the section body is not empty.
+     */
+    void setIndexStorage(const Storage storage);
+
+    /**
+     * @brief Reads the binary body block by block, widened to 64 bits (i.e., the point count of each cell followed by
+     *        its point indexes).
+     * @param visit The function that receives each block (i.e., the pointer to the values and their count).
+     * @throws If the section is not in the binary encoding or its body could not be read.
+     */
+    void readBinary(const std::function<void(const std::int64_t *, const Size)> & visit) const;
+
     /**
      * @brief Appends a cell to the section having the index map and the type of the cell.
      * @tparam ITRT An iterative type.
@@ -73,12 +101,77 @@ public:
         if (pointIndexes.size() > Cell::maxPoints(type))
             throw  std::range_error("The cell requires less point indexes.");
 
-        bodyPtr()->appendCell(pointIndexes.size(), false);
-        bodyPtr()->appendRow(pointIndexes, false);
-        bodyPtr()->nextRow();
-        return bodyPtr()->rowIndex();
+        for (const auto index : pointIndexes)
+            checkIndex(index);
+        const auto & body = bodyPtr();
+        body->appendCell(pointIndexes.size(), format());
+        body->appendRow(pointIndexes, format());
+        body->nextRow();
+        return body->rowIndex();
     }
 
+    /**
+     * @brief Appends a cell to the section having consecutive point indexes (e.g., the points appended along with the cell).
+     * @param type The type of the cell.
+     * @param first The index of the first point of the cell.
+     * @param count The number of the points of the cell.
+     * @returns The number of cells currently exist on the body.
+     * @throws If the number of point indexes not match with the type of the cell.
+     * @throws If the cell could not be appended.
+     */
+    CellIndex appendCell(const CellType type, const PointIndex first, const Size count);
+
+    /**
+     * @brief Appends a number of cells of the same type to the section having their flat connectivity array.
+     * @note The connectivity is validated once and the cells are written block by block (see CSVFile::appendCells).
+     * @param type The type of the cells.
+     * @param connectivity The point indexes of the cells, cell after cell.
+     * @param pointsPerCell The number of points of each cell, zero to use the fixed number of points of the type.
+     * @returns The number of cells currently exist on the body.
+     * @throws If the pointsPerCell is zero and the type does not have a fixed number of points.
+     * @throws If the number of points per cell not match with the type of the cells.
+     * @throws If the connectivity does not hold a whole number of cells.
+     * @throws If the cells could not be appended.
+     */
+    CellIndex appendCells(const CellType type, Span<const PointIndex> connectivity, Size pointsPerCell = 0);
+
+    /**
+     * @brief Appends a mesh of mixed cells to the section having it in the compressed sparse row (CSR) form.
+     * @note The point indexes of the i-th cell are connectivity[offsets[i]] to connectivity[offsets[i + 1] - 1].
+     * @note All the cells are validated before appending any of them, then written block by block (see CSVFile::appendCells).
+     * @param types The types of the cells.
+     * @param offsets The offsets of the cells inside the connectivity, one more than the cells.
+     * @param connectivity The point indexes of the cells.
+     * @returns The number of cells currently exist on the body.
+     * @throws If the number of the offsets is not one more than the number of the types.
+     * @throws If the offsets are decreasing or exceed the connectivity.
+     * @throws If the number of point indexes of any cell not match with the type of the cell.
+     * @throws If the cells could not be appended.
+     */
+    CellIndex appendCells(Span<const CellType> types, Span<const PointIndex> offsets, Span<const PointIndex> connectivity);
+
+protected:
+
+    /**
+     * @brief Resolves the number format of the body's content for the current encoding and the index storage.
+     */
+    virtual void updateFormat() override;
+
+private:
+
+    /**
+     * @brief Checks whether a point index fits in the stored type of the indexes or not.
+     * @param index The point index.
+     * @throws If the index does not fit in the Int32 of the binary encoding.
+     */
+    void checkIndex(const PointIndex index) const {
+        if (format().isBinary() && format().storage() == Storage::Int32
+                && index > static_cast<PointIndex>(std::numeric_limits<std::int32_t>::max()))
+            throw std::range_error("The point index does not fit in the Int32 indexes of the cell section.");
+    }
+
+    Storage p_indexStorage; // The type the point indexes are stored as in the binary encoding.
+
 };
 
 } // namespace exporting
@@ -12,6 +12,8 @@ namespace exporting {
 
 VTKCellTypeSection::VTKCellTypeSection(const std::string &name)
     : VTKSection{name + "_" + VTKSection::to_string(Type::CellTypes), Type::CellTypes}
+    , p_cellCount{0}
+    , p_runs{}
 {
     bodyPtr()->setSeperator(" ");
 }
@@ -22,16 +24,43 @@ VTKCellTypeSection::VTKCellTypeSection(const std::string &path, const std::strin
 }
 
 VTKCellTypeSection::Size VTKCellTypeSection::cellCount() const {
-    return body().rowIndex();
+    return p_cellCount;
+}
+
+void VTKCellTypeSection::detachBody() {
+    VTKSection::detachBody();
+    p_cellCount = 0;
+    p_runs.clear();
 }
 
 std::string VTKCellTypeSection::header() const {
-    return "CELL_TYPES " + std::to_string(body().rowIndex());
+    return "CELL_TYPES " + std::to_string(p_cellCount);
 }
 
 VTKCellTypeSection::CellIndex VTKCellTypeSection::appendCell(const VTKCellTypeSection::CellType type) {
-    bodyPtr()->appendCell(Cell::code(type), false);
-    return bodyPtr()->rowIndex();
+    return appendCells(type, 1);
+}
+
+VTKCellTypeSection::CellIndex VTKCellTypeSection::appendCells(const VTKCellTypeSection::CellType type,
+                                                              const VTKCellTypeSection::Size count) {
+    if (!count)
+        return p_cellCount;
+    if (!p_runs.empty() && p_runs.back().type == type)
+        p_runs.back().count += count;
+    else
+        p_runs.push_back(Run{type, count});
+    p_cellCount += count;
+    return p_cellCount;
+}
+
+VTKCellTypeSection::CellIndex VTKCellTypeSection::appendCells(Span<const VTKCellTypeSection::CellType> types) {
+    for (const auto type : types)
+        appendCells(type, 1);
+    return p_cellCount;
+}
+
+const VTKCellTypeSection::Runs &VTKCellTypeSection::runs() const {
+    return p_runs;
 }
 
 } // namespace exporting
@@ -9,8 +9,11 @@
 #ifndef VTKCELLTYPESECTION_H
 #define VTKCELLTYPESECTION_H
 
+#include "../Span.h"
 #include "VTKCell.h"
 #include "VTKSection.h"
+#include <algorithm>
+#include <vector>
 
 /**
  * The exporting namespace provides the means to handle exporting simulation data to files.
@@ -19,6 +22,8 @@ namespace exporting {
 
 /**
  * The VTKCellTypeSection class provides the means to handle exporting cell-type map to the tempvtk file.
+ * @note The cell types are kept in memory as runs of the same type (i.e., run-length encoded) instead of the body,
+ *       and are expanded only when the CELL_TYPES block of the vtk file is written (see expand).
  */
 class VTKCellTypeSection: public VTKSection
 {
@@ -29,6 +34,16 @@ public:
     using CellType = VTKCell::Type;
     using Size = unsigned long;
 
+    /**
+     * @brief A run of the consecutive cells having the same type.
+     */
+    struct Run {
+        CellType type;  // The type of the cells.
+        Size count;     // The number of the cells.
+    };
+
+    using Runs = std::vector<Run>;
+
     /**
      * @brief The constructor.
      * @param name The name of the parent VTK file (the path to the file included).
@@ -43,10 +58,32 @@ public:
     explicit VTKCellTypeSection(const std::string &path, const std::string &name);
 
     /**
-     * @brief Gives the number of cells inside the body.
+     * @brief Gives the number of cells inside the section.
      */
     Size cellCount() const;
 
+    /**
+     * @brief Expands the runs of the cell types into the codes of the cells, block by block.
+     * @tparam VISITOR The function receiving each block, having the signiture: void (const Cell::Code * codes, Size size).
+     * @param runs The runs of the cell types.
+     * @param visit The visitor function.
+     */
+    template<typename VISITOR>
+    static void expand(const Runs & runs, VISITOR visit) {
+        constexpr Size blockSize = 1 << 12;
+        Cell::Code codes[blockSize];
+        for (const auto & run : runs) {
+            std::fill(codes, codes + std::min(run.count, blockSize), Cell::code(run.type));
+            for (Size done = 0; done < run.count; done += blockSize)
+                visit(static_cast<const Cell::Code *>(codes), std::min(run.count - done, blockSize));
+        }
+    }
+
+    /**
+     * @brief Lets go of the body and the runs of the cell types, and continues with no cells (see VTKSection::detachBody).
+     */
+    virtual void detachBody() override;
+
     /**
      * @brief Gives the header of the points section.
      */
@@ -55,10 +92,35 @@ public:
     /**
      * @brief Appends a cell to the section having the type of the cell
      * @param type The type of the cell.
-     * @returns The number of cells currently exist on the body.
+     * @returns The number of cells currently exist on the section.
      */
     CellIndex appendCell(const CellType type);
 
+    /**
+     * @brief Appends a number of cells of the same type to the section in one pass.
+     * @param type The type of the cells.
+     * @param count The number of the cells.
+     * @returns The number of cells currently exist on the section.
+     */
+    CellIndex appendCells(const CellType type, const Size count);
+
+    /**
+     * @brief Appends a number of cells of mixed types to the section in one pass.
+     * @param types The types of the cells.
+     * @returns The number of cells currently exist on the section.
+     */
+    CellIndex appendCells(Span<const CellType> types);
+
+    /**
+     * @brief Gives the runs of the cell types.
+     */
+    const Runs & runs() const;
+
+private:
+
+    Size p_cellCount;   // The number of the cells.
+    Runs p_runs;        // The runs of the cell types, in order.
+
 };
 
 } // namespace exporting
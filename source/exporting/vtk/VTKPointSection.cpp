@@ -14,6 +14,7 @@ VTKPointSection::VTKPointSection(const std::string &name)
     : VTKSection{name + "_" + VTKSection::to_string(Type::Points), Type::Points}
 {
     bodyPtr()->setSeperator(" ");
+    updateFormat();
 }
 
 VTKPointSection::VTKPointSection(const std::string &path, const std::string &name)
@@ -33,9 +34,10 @@ std::string VTKPointSection::header() const
 VTKPointSection::PointIndex VTKPointSection::appendPoint(VTKPointSection::Dimension x,
                                                          VTKPointSection::Dimension y,
                                                          VTKPointSection::Dimension z){
-    if (!bodyPtr()->appendCell(x, true)
-            || !bodyPtr()->appendCell(y, true)
-            || !bodyPtr()->appendCell(z, true))
+    const auto & body = bodyPtr();
+    if (!body->appendCell(x, format())
+            || !body->appendCell(y, format())
+            || !body->appendCell(z, format()))
         throw std::runtime_error("Could not append one of the point dimension to the file.");
     return currentPointIndex();
 }
@@ -46,7 +48,7 @@ VTKPointSection::PointIndex VTKPointSection::appendPoint(const VTKPointSection::
     return appendPoint(dimensions[0], dimensions[1], dimensions[2]);
 }
 
-std::vector<VTKPointSection::PointIndex> VTKPointSection::appendPoints(std::vector<VTKPointSection::Dimension> dimensions){
+std::vector<VTKPointSection::PointIndex> VTKPointSection::appendPoints(const std::vector<VTKPointSection::Dimension> & dimensions){
     std::vector<PointIndex> ans;
     if(dimensions.empty())
         return ans;
@@ -56,7 +58,7 @@ std::vector<VTKPointSection::PointIndex> VTKPointSection::appendPoints(std::vect
     ans.reserve(dimensions.size() / 3);
     ans.emplace_back(pointCount());
 
-    if ( bodyPtr()->appendRow(dimensions, true) != dimensions.size() )
+    if ( bodyPtr()->appendRow(dimensions, format()) != dimensions.size() )
         throw std::runtime_error("Could not append one of the point dimension to the file.");
 
     const auto last = currentPointIndex();
@@ -65,8 +67,45 @@ std::vector<VTKPointSection::PointIndex> VTKPointSection::appendPoints(std::vect
     return ans;
 }
 
+VTKPointSection::PointIndex VTKPointSection::appendPoints(Span<const VTKPointSection::Dimension> xyz) {
+    if(xyz.size() % 3)
+        throw std::range_error("The points of vtk has to have 3 dimensions (3D).");
+    const auto ans = pointCount();
+    if (bodyPtr()->appendCells(xyz.data(), xyz.size(), 0, format()) != xyz.size())
+        throw std::runtime_error("Could not append one of the point dimension to the file.");
+    return ans;
+}
+
+VTKPointSection::PointIndex VTKPointSection::appendPoints(Span<const VTKPointSection::Dimension> x,
+                                                          Span<const VTKPointSection::Dimension> y,
+                                                          Span<const VTKPointSection::Dimension> z) {
+    if (x.size() != y.size() || x.size() != z.size())
+        throw std::range_error("The x, y, and z of the points should have the same size.");
+    return appendInterleaved(x.size(), [&x, &y, &z](const Size index, Dimension * point) {
+        point[0] = x[index];
+        point[1] = y[index];
+        point[2] = z[index];
+    });
+}
+
+VTKPointSection::PointIndex VTKPointSection::appendPoints(StridedSpan<const VTKPointSection::Dimension> points) {
+    return appendInterleaved(points.size(), [&points](const Size index, Dimension * point) {
+        const auto dimensions = points.at(index);
+        point[0] = dimensions[0];
+        point[1] = dimensions[1];
+        point[2] = dimensions[2];
+    });
+}
+
 VTKPointSection::PointIndex VTKPointSection::currentPointIndex() const {
     return body().cellCount() / 3 - 1;
 }
 
+void VTKPointSection::updateFormat() {
+    if (encoding() == Encoding::Binary)
+        setFormat(NumberFormat::binary(NumberFormat::Storage::Float64));
+    else
+        setFormat(NumberFormat::of<Dimension>(true));
+}
+
 } // namespace exporting
@@ -9,7 +9,11 @@
 #ifndef VTKPOINTSECTION_H
 #define VTKPOINTSECTION_H
 
+#include "../Span.h"
+#include "VTKPointTraits.h"
 #include "VTKSection.h"
+#include <algorithm>
+#include <array>
 #include <vector>
 
 /**
@@ -26,6 +30,7 @@ public:
 
     using Dimension = double;
     using Point = std::vector<Dimension>;
+    using Point3 = std::array<Dimension, 3>;
     using PointIndex = unsigned long;
     using Size = unsigned long;
 
@@ -70,38 +75,118 @@ public:
      */
     PointIndex appendPoint(const Point & dimensions);
 
+    /**
+     * @brief Appends a fixed-size point (e.g., a Point3) to the body of the section without any heap allocation.
+     * @tparam POINT A point type having the VTKPointTraits.
+     * @param point The point.
+     * @return The index of the added point to the body.
+     * @throws If the point could not be appended.
+     */
+    template<typename POINT, typename = std::enable_if_t<VTKPointTraits<POINT>::isPoint> >
+    PointIndex appendPoint(const POINT & point) {
+        using Traits = VTKPointTraits<POINT>;
+        const Dimension dimensions[3] = {Traits::x(point), Traits::y(point), Traits::z(point)};
+        if (bodyPtr()->appendCells(dimensions, 3, 0, format()) != 3)
+            throw std::runtime_error("Could not append one of the point dimension to the file.");
+        return currentPointIndex();
+    }
+
     /**
      * @brief Appends points to the body of the section.
      * @param dimensions The dimension of the point in sereis (i.g., x_0, y_0, z_0, x_1, y_1, ...).
      * @return The indexes of the points.
      * @throws If the dimensions size is not a factor of 3.
      */
-    std::vector<PointIndex> appendPoints(std::vector<Dimension> dimensions);
+    std::vector<PointIndex> appendPoints(const std::vector<Dimension> & dimensions);
+
+    /**
+     * @brief Appends packed points to the body of the section without copying them.
+     * @param xyz The dimension of the points in sereis (i.g., x_0, y_0, z_0, x_1, y_1, ...).
+     * @return The index of the first added point (i.e., the points have consecutive indexes).
+     * @throws If the dimensions size is not a factor of 3.
+     * @throws If the points could not be appended.
+     */
+    PointIndex appendPoints(Span<const Dimension> xyz);
+
+    /**
+     * @brief Appends points stored as structure of arrays (SoA) to the body of the section without copying them.
+     * @param x The x of the points.
+     * @param y The y of the points.
+     * @param z The z of the points.
+     * @return The index of the first added point (i.e., the points have consecutive indexes).
+     * @throws If the sizes of the x, y, and z are not the same.
+     * @throws If the points could not be appended.
+     */
+    PointIndex appendPoints(Span<const Dimension> x, Span<const Dimension> y, Span<const Dimension> z);
+
+    /**
+     * @brief Appends points embedded inside a larger array (e.g., the position of the particle structs) to the body
+     *        of the section without copying the array.
+     * @note The x, y, and z of each point are read contiguously from the begining of each element.
+     * @param points The strided view of the points.
+     * @return The index of the first added point (i.e., the points have consecutive indexes).
+     * @throws If the points could not be appended.
+     */
+    PointIndex appendPoints(StridedSpan<const Dimension> points);
 
     /**
      * @brief Appends points to the body of the section.
      * @note VTK format only accepts 3D points.
-     * @tparam T A type with a member signicure as: const std::vector<Dimension>& dimensions() const;
+     * @tparam T The Point type or a point type having the VTKPointTraits.
      * @param points The points to append to the body.
      * @return The indexes of the points.
-     * @throws If the member return std::vector of other lenght than 3.
+     * @throws If any of the points is a Point of other lenght than 3.
      */
     template<typename T>
-    std::vector<PointIndex> appendPoints(std::vector<T> points) {
+    std::vector<PointIndex> appendPoints(const std::vector<T> & points) {
         std::vector<PointIndex> ans;
         ans.reserve(points.size());
-        for(const auto point: points)
+        for(const auto & point: points)
             ans.emplace_back(appendPoint(point));
         return ans;
     }
 
 protected:
 
+    /**
+     * @brief Appends points to the body, gathering them block by block into the packed form (i.e., x_0, y_0, z_0, x_1, ...).
+     * @tparam GATHER The functor that copies the dimensions of a point, having the signiture: void (Size index, Dimension * point).
+     * @param count The number of the points.
+     * @param gather The gathering functor.
+     * @return The index of the first added point.
+     * @throws If the points could not be appended.
+     */
+    template<typename GATHER>
+    PointIndex appendInterleaved(const Size count, GATHER gather) {
+        constexpr Size blockSize = 1 << 11;
+        Dimension stackBlock[blockSize * 3];
+        // The large inputs are gathered in larger blocks, so that the pool can format each block in parallel.
+        const auto threads = file_system::WorkerPool::current().threadCount();
+        const auto perBlock = (count > blockSize && threads > 1) ? threads * CSVFile::parallelChunk : blockSize;
+        std::vector<Dimension> heapBlock((perBlock > blockSize) ? 3 * perBlock : 0);
+        const auto block = (perBlock > blockSize) ? heapBlock.data() : stackBlock;
+        const auto ans = pointCount();
+        const auto & body = bodyPtr();
+        for (Size done = 0; done < count; done += perBlock) {
+            const auto size = std::min(count - done, perBlock);
+            for (Size i = 0; i < size; i++)
+                gather(done + i, block + 3 * i);
+            if (body->appendCells(block, 3 * size, 0, format()) != 3 * size)
+                throw std::runtime_error("Could not append one of the point dimension to the file.");
+        }
+        return ans;
+    }
+
     /**
      * @brief Gives the last index of the point inside body.
      */
     PointIndex currentPointIndex() const;
 
+    /**
+     * @brief Resolves the number format of the points (i.e., scientific or raw double) for the current encoding.
+     */
+    virtual void updateFormat() override;
+
 };
 
 } // namespace exporting
@@ -0,0 +1,82 @@
+//
+//  VTKPointTraits.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef VTKPOINTTRAITS_H
+#define VTKPOINTTRAITS_H
+
+#include <array>
+#include <iterator>
+#include <type_traits>
+
+/**
+ * The exporting namespace provides the means to handle exporting simulation data to files.
+ */
+namespace exporting {
+
+/**
+ * @brief The VTKPointTraits struct provides the means to read the coordinates of a fixed-size point type.
+ * @details The point types having the traits can be appended to the vtk files without any conversion or heap allocation.
+ *          Specialize it to use a custom point type (e.g., a Vec3 struct of the simulation), for example:
+ *          @code
+ *          template<>
+ *          struct exporting::VTKPointTraits<Vec3> {
+ *              static constexpr bool isPoint = true;
+ *              static double x(const Vec3 & point) { return point.x(); }
+ *              static double y(const Vec3 & point) { return point.y(); }
+ *              static double z(const Vec3 & point) { return point.z(); }
+ *          };
+ *          @endcode
+ * @note Is already specialized for the std::array<N, 3>, N[3], and the types having public x, y, and z data members.
+ * @tparam POINT The point type.
+ */
+template<typename POINT, typename = void>
+struct VTKPointTraits {
+    static constexpr bool isPoint = false;
+};
+
+template<typename N>
+struct VTKPointTraits<std::array<N, 3>, std::enable_if_t<std::is_arithmetic_v<N> > > {
+    static constexpr bool isPoint = true;
+    static double x(const std::array<N, 3> & point) { return static_cast<double>(point[0]); }
+    static double y(const std::array<N, 3> & point) { return static_cast<double>(point[1]); }
+    static double z(const std::array<N, 3> & point) { return static_cast<double>(point[2]); }
+};
+
+template<typename N>
+struct VTKPointTraits<N[3], std::enable_if_t<std::is_arithmetic_v<N> > > {
+    static constexpr bool isPoint = true;
+    static double x(const N (&point)[3]) { return static_cast<double>(point[0]); }
+    static double y(const N (&point)[3]) { return static_cast<double>(point[1]); }
+    static double z(const N (&point)[3]) { return static_cast<double>(point[2]); }
+};
+
+template<typename POINT>
+struct VTKPointTraits<POINT, std::void_t<decltype(static_cast<double>(std::declval<const POINT &>().x)),
+                                         decltype(static_cast<double>(std::declval<const POINT &>().y)),
+                                         decltype(static_cast<double>(std::declval<const POINT &>().z))> > {
+    static constexpr bool isPoint = true;
+    static double x(const POINT & point) { return static_cast<double>(point.x); }
+    static double y(const POINT & point) { return static_cast<double>(point.y); }
+    static double z(const POINT & point) { return static_cast<double>(point.z); }
+};
+
+/**
+ * @brief Whether the POINTS type is an iterable of points having the VTKPointTraits and a size or not.
+ * @tparam POINTS The iterable type (e.g., std::vector<std::array<double, 3> >).
+ */
+template<typename POINTS, typename = void>
+struct isVTKPointRange: std::false_type {};
+
+template<typename POINTS>
+struct isVTKPointRange<POINTS, std::void_t<decltype(std::size(std::declval<const POINTS &>())),
+                                           decltype(*std::begin(std::declval<const POINTS &>()))> >
+        : std::bool_constant<VTKPointTraits<std::decay_t<decltype(*std::begin(std::declval<const POINTS &>()))> >::isPoint> {};
+
+} // namespace exporting
+
+#endif // VTKPOINTTRAITS_H
@@ -0,0 +1,64 @@
+//
+//  VTKPointWelder.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "VTKPointWelder.h"
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace exporting {
+
+VTKPointWelder::VTKPointWelder(const VTKPointWelder::Dimension tolerance)
+    : p_indexes{}
+    , p_tolerance{tolerance}
+{
+    if (!(tolerance >= 0))
+        throw std::range_error("The welding tolerance cannot be negative.");
+}
+
+VTKPointWelder::Size VTKPointWelder::size() const {
+    return p_indexes.size();
+}
+
+VTKPointWelder::Dimension VTKPointWelder::tolerance() const {
+    return p_tolerance;
+}
+
+void VTKPointWelder::clear() {
+    p_indexes.clear();
+}
+
+std::pair<VTKPointWelder::PointIndex, bool> VTKPointWelder::weld(const VTKPointWelder::Dimension x,
+                                                                 const VTKPointWelder::Dimension y,
+                                                                 const VTKPointWelder::Dimension z,
+                                                                 const VTKPointWelder::PointIndex next) {
+    const auto ans = p_indexes.try_emplace(Key{keyOf(x), keyOf(y), keyOf(z)}, next);
+    return {ans.first->second, ans.second};
+}
+
+VTKPointWelder::Size VTKPointWelder::KeyHash::operator()(const VTKPointWelder::Key &key) const {
+    // Mixes the coordinates (the 64-bit golden ratio and the splitmix64 finalizer).
+    std::uint64_t hash = 0;
+    for (const auto value : {key.x, key.y, key.z})
+        hash = (hash ^ static_cast<std::uint64_t>(value)) * 0x9e3779b97f4a7c15ull;
+    hash ^= hash >> 31;
+    hash *= 0xbf58476d1ce4e5b9ull;
+    hash ^= hash >> 27;
+    return static_cast<Size>(hash);
+}
+
+std::int64_t VTKPointWelder::keyOf(const VTKPointWelder::Dimension dimension) const {
+    if (p_tolerance > 0)
+        return static_cast<std::int64_t>(std::floor(dimension / p_tolerance));
+    std::int64_t ans;
+    const Dimension normal = dimension + 0.0; // -0.0 and 0.0 are the same point.
+    std::memcpy(&ans, &normal, sizeof(ans));
+    return ans;
+}
+
+} // namespace exporting
@@ -0,0 +1,104 @@
+//
+//  VTKPointWelder.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef VTKPOINTWELDER_H
+#define VTKPOINTWELDER_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * The exporting namespace provides the means to handle exporting simulation data to files.
+ */
+namespace exporting {
+
+/**
+ * @brief The VTKPointWelder class provides the means to find the points that are already appended to a point section
+ *        (i.e., welding the shared nodes of the cells into one point).
+ * @details The points are kept in a hash map from their coordinates to their index. With a zero tolerance the
+ *          coordinates should match exactly; otherwise the coordinates are quantised to the tolerance, so the points
+ *          falling in the same tolerance-sized box are welded.
+ * @note Two points closer than the tolerance but on the two sides of a box boundary are not welded.
+ */
+class VTKPointWelder
+{
+public:
+
+    using Dimension = double;
+    using PointIndex = unsigned long;
+    using Size = std::size_t;
+
+    /**
+     * @brief The constructor.
+     * @param tolerance The size of the quantisation box, zero for the exact coordinates.
+     * @throws If the tolerance is negative.
+     */
+    explicit VTKPointWelder(const Dimension tolerance = 0);
+
+    /**
+     * @brief Gives the number of the distinct points.
+     */
+    Size size() const;
+
+    /**
+     * @brief Gives the size of the quantisation box, zero for the exact coordinates.
+     */
+    Dimension tolerance() const;
+
+    /**
+     * @brief Removes all the points.
+     */
+    void clear();
+
+    /**
+     * @brief Finds the index of a point, registers the point if it is not found.
+     * @param x The x of the point.
+     * @param y The y of the point.
+     * @param z The z of the point.
+     * @param next The index that the point will have if it is not found (i.e., the number of the appended points).
+     * @return The index of the point, and whether it is a new point (i.e., should be appended) or not.
+     */
+    std::pair<PointIndex, bool> weld(const Dimension x, const Dimension y, const Dimension z, const PointIndex next);
+
+private:
+
+    /**
+     * @brief The hash key of the point (i.e., the exact or quantised coordinates).
+     */
+    struct Key {
+        std::int64_t x;
+        std::int64_t y;
+        std::int64_t z;
+
+        bool operator==(const Key & other) const {
+            return x == other.x && y == other.y && z == other.z;
+        }
+    };
+
+    /**
+     * @brief The hash function of the key.
+     */
+    struct KeyHash {
+        Size operator()(const Key & key) const;
+    };
+
+    /**
+     * @brief Gives the key of a coordinate.
+     * @param dimension The coordinate.
+     */
+    std::int64_t keyOf(const Dimension dimension) const;
+
+    std::unordered_map<Key, PointIndex, KeyHash> p_indexes;     // The index of the points.
+    Dimension p_tolerance;                                      // The size of the quantisation box.
+
+};
+
+} // namespace exporting
+
+#endif // VTKPOINTWELDER_H
@@ -12,9 +12,14 @@ namespace exporting {
 
 VTKSection::VTKSection(const std::string &name, VTKSection::Type type)
     : p_bodyPtr{std::make_shared<Body>(name, "tempvtk")}
+    , p_encoding{Encoding::Ascii}
+    , p_format{}
     , p_type{type}
 {
     p_bodyPtr->maxColumn() = tableCellPerRow(p_type);
+    p_bodyPtr->setSpillThreshold(defaultSpillThreshold);
+    p_bodyPtr->setMemoryResident(true);
+    p_bodyPtr->remove(); // The body is spilled by appending, the leftovers of any previous run should go.
 }
 
 VTKSection::VTKSection(const std::string &path,
@@ -47,6 +52,14 @@ std::string VTKSection::to_string(const VTKSection::Type type) {
     return "";
 }
 
+std::string VTKSection::to_string(const VTKSection::Encoding encoding) {
+    switch (encoding) {
+    case Encoding::Ascii:     return "ASCII";
+    case Encoding::Binary:    return "BINARY";
+    }
+    throw std::range_error("The encoding of the section is out of known range.");
+}
+
 std::string VTKSection::header() const {
     throw std::logic_error("The VTKSection dow not have a header.");
 }
@@ -55,6 +68,10 @@ const VTKSection::Body & VTKSection::body() const {
     return *p_bodyPtr;
 }
 
+VTKSection::Encoding VTKSection::encoding() const {
+    return p_encoding;
+}
+
 const std::string VTKSection::path() const {
     return body().fullName(true);
 }
@@ -63,20 +80,72 @@ VTKSection::Type VTKSection::type() const {
     return p_type;
 }
 
+void VTKSection::redirectBody(const std::string &name, const std::string &extension, const std::string &preamble) {
+    if (body().cellCount())
+        throw std::runtime_error("Cannot redirect the body of the section if it is not empty.");
+    const auto redirected = std::make_shared<Body>(name, extension);
+    redirected->setSeperator(p_bodyPtr->seperator());
+    redirected->maxColumn() = p_bodyPtr->maxColumn();
+    redirected->setBinary(p_bodyPtr->isBinary());
+    redirected->setSpillThreshold(0); // The new file is written right away, so it is flushed on save.
+    redirected->open(true);
+    redirected->TextFile::append(preamble);
+    p_bodyPtr->remove();
+    p_bodyPtr = redirected;
+}
+
+void VTKSection::detachBody() {
+    const auto & body = *p_bodyPtr;
+    const auto detached = std::make_shared<Body>(body.name(true), body.extension());
+    detached->setSeperator(body.seperator());
+    detached->maxColumn() = body.maxColumn();
+    detached->setBinary(body.isBinary());
+    detached->setSpillThreshold(body.spillThreshold());
+    detached->setMemoryResident(body.isMemoryResident());
+    p_bodyPtr = detached;
+}
+
 bool VTKSection::removeBody() {
     return bodyPtr()->remove();
 }
 
 bool VTKSection::save() {
-    return bodyPtr()->save();
+    return !body().isSpilled() || bodyPtr()->save();
+}
+
+void VTKSection::setSpillThreshold(const VTKSection::Size threshold) {
+    bodyPtr()->setSpillThreshold(threshold);
+}
+
+void VTKSection::setEncoding(const VTKSection::Encoding encoding) {
+    if (encoding == p_encoding)
+        return;
+    if (body().cellCount())
+        throw std::runtime_error("Cannot change the encoding of the section if the body is not empty.");
+    p_encoding = encoding;
+    bodyPtr()->setBinary(p_encoding == Encoding::Binary);
+    updateFormat();
 }
 
 const VTKSection::Body_ptr &VTKSection::bodyPtr() {
-    if (!p_bodyPtr->isOpen())
-        p_bodyPtr->open(true);
     return p_bodyPtr;
 }
 
+const NumberFormat &VTKSection::format() const {
+    return p_format;
+}
+
+void VTKSection::setFormat(const NumberFormat &format) {
+    p_format = format;
+}
+
+void VTKSection::updateFormat() {
+    if (p_encoding == Encoding::Binary)
+        setFormat(NumberFormat::binary(NumberFormat::Storage::Int32));
+    else
+        setFormat(NumberFormat());
+}
+
 std::ostream &operator <<(std::ostream &out, const VTKSection::Type &type) {
     using Type = VTKSection::Type;
     switch (type) {
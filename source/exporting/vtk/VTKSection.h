@@ -20,7 +20,9 @@ namespace exporting {
  * @brief The VTKSection class provides the means to handle diferent type of the vtk sections.
  * @details This class provides a header and body subsections, where the body is stored on
  *          a temporary CSV file (with " " separator and "tempvtk" extension) on the
- *          machine filesystem.
+ *          machine filesystem. The body is kept in memory and only spilled to the temp file once
+ *          it exceeds the spill threshold, so the small sections never touch the file system. In the binary encoding the body holds the raw big-endian
+ *          values, ready to be copied into a legacy binary vtk file.
  * @note The storage of body data on a file reduces the overall memory cost.
  * @note The class is not default constructable.
  * @note The class is not copiable or moveable.
@@ -31,6 +33,9 @@ public:
 
     using Body = CSVFile;
     using CellNumber = unsigned long;
+    using Size = file_system::SingleFile::Size;
+
+    static constexpr Size defaultSpillThreshold = 1 << 20; // The size of the body kept in memory before it is written to the temp file.
 
     /**
      * @brief Each vtk file has several sections.
@@ -43,6 +48,14 @@ public:
         Attribute       // Containt the information of the points or cell attributes (i.e., scalar, vector, tensor).
     };
 
+    /**
+     * @brief The encoding of the section's body.
+     */
+    enum class Encoding {
+        Ascii,          // The values are stored as text.
+        Binary          // The values are stored as raw big-endian numbers.
+    };
+
     /**
      * @brief The constructor.
      * @param name The name of the parent VTK file (the path to the file included).
@@ -72,6 +85,13 @@ public:
      */
     static std::string to_string(const Type type);
 
+    /**
+     * @brief Converts the encoding to the std::string used in the vtk file header.
+     * @param encoding The encoding.
+     * @return The equivalent std::string of the encoding (i.e., ASCII or BINARY).
+     */
+    static std::string to_string(const Encoding encoding);
+
     /**
      * @brief Gives the header of the section.
      */
@@ -82,6 +102,16 @@ public:
      */
     const Body & body() const;
 
+    /**
+     * @brief Gives the encoding of the section's body.
+     */
+    Encoding encoding() const;
+
+    /**
+     * @brief Gives the number format of the body's content.
+     */
+    const NumberFormat & format() const;
+
     /**
      * @brief Gives the path of the file.
      */
@@ -92,18 +122,49 @@ public:
      */
     Type type() const;
 
+    /**
+     * @brief Redirects the body to another file (e.g., the final vtk file), right after a preamble.
+     * @note The temp file of the body is removed and the content is written to the new file from now on.
+     * @param name The name of the new file (the path to the file included).
+     * @param extension The extention of the new file without the dot(.).
+     * @param preamble The text written at the begining of the new file, before the body.
+     * @throws If the section body is not empty.
+     */
+    void redirectBody(const std::string & name, const std::string & extension, const std::string & preamble);
+
     /**
      * @brief Removes the body (file) of the section without moving to bin.
      * @return True, if successful, false otherwise.
      */
     bool removeBody();
 
+    /**
+     * @brief Lets go of the body (e.g., once a copy of the section takes it over for the background assembly) and
+     *        continues with a new empty body kept in memory.
+     * @note The temp file of the old body is not touched, it belongs to the sections sharing the old body.
+     */
+    virtual void detachBody();
+
     /**
      * @brief Flushes the body temp file but keeps it open!
+     * @note The body that is only kept in memory is left as is.
      * @return True if successful, false otherwise.
      */
     bool save();
 
+    /**
+     * @brief Sets the size of the body kept in memory before it is written to the temp file.
+     * @param threshold The number of bytes (zero to write to the temp file right away).
+     */
+    void setSpillThreshold(const Size threshold);
+
+    /**
+     * @brief Sets the encoding of the section's body.
+     * @param encoding The new encoding.
+     * @throws If the section body is not empty.
+     */
+    void setEncoding(const Encoding encoding);
+
     friend std::ostream & operator << (std::ostream & out, const Type & type);
 
 protected:
@@ -115,9 +176,24 @@ protected:
      */
     const Body_ptr & bodyPtr();
 
+    /**
+     * @brief Sets the number format of the body's content.
+     * @note The format is resolved once and used for all the numbers appended afterward.
+     * @param format The new number format.
+     */
+    void setFormat(const NumberFormat & format);
+
+    /**
+     * @brief Resolves the number format of the body's content for the current encoding.
+     * @note The default is the integer format (i.e., int in the binary encoding).
+     */
+    virtual void updateFormat();
+
 private:
 
     Body_ptr p_bodyPtr;
+    Encoding p_encoding;    // The encoding of the body's content.
+    NumberFormat p_format;  // The number format of the body's content.
     const Type p_type;
 
 };
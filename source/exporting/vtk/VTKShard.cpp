@@ -0,0 +1,102 @@
+//
+//  VTKShard.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "VTKShard.h"
+
+namespace exporting {
+
+VTKShard::VTKShard()
+    : p_doubleAttributes{}
+    , p_floatAttributes{}
+    , p_intAttributes{}
+    , p_connectivity{}
+    , p_offsets{0}
+    , p_points{}
+    , p_types{}
+{
+}
+
+VTKShard::Size VTKShard::cellCount() const {
+    return p_types.size();
+}
+
+VTKShard::Size VTKShard::pointCount() const {
+    return p_points.size() / 3;
+}
+
+bool VTKShard::empty() const {
+    return p_points.empty() && p_types.empty()
+            && p_doubleAttributes.empty() && p_floatAttributes.empty() && p_intAttributes.empty();
+}
+
+void VTKShard::clear() {
+    p_doubleAttributes.clear();
+    p_floatAttributes.clear();
+    p_intAttributes.clear();
+    p_connectivity.clear();
+    p_offsets.assign(1, 0);
+    p_points.clear();
+    p_types.clear();
+}
+
+VTKShard::PointIndex VTKShard::appendPoint(const VTKShard::Dimension x,
+                                           const VTKShard::Dimension y,
+                                           const VTKShard::Dimension z) {
+    const auto ans = pointCount();
+    p_points.insert(p_points.end(), {x, y, z});
+    return ans;
+}
+
+VTKShard::PointIndex VTKShard::appendPoints(Span<const VTKShard::Dimension> xyz) {
+    if (xyz.size() % 3 != 0)
+        throw std::range_error("The points of vtk has to have 3 dimensions (3D).");
+    const auto ans = pointCount();
+    p_points.insert(p_points.end(), xyz.begin(), xyz.end());
+    return ans;
+}
+
+void VTKShard::appendCell(const VTKShard::CellType type, Span<const VTKShard::PointIndex> cellPointsMap) {
+    p_connectivity.insert(p_connectivity.end(), cellPointsMap.begin(), cellPointsMap.end());
+    p_offsets.emplace_back(p_connectivity.size());
+    p_types.emplace_back(type);
+}
+
+void VTKShard::appendCell(const VTKShard::CellType type, const std::vector<std::vector<VTKShard::Dimension> > &points) {
+    const auto first = pointCount();
+    for (const auto & point : points) {
+        if (point.size() != 3)
+            throw std::range_error("The points of vtk has to have 3 dimensions (3D).");
+        appendPoint(point[0], point[1], point[2]);
+    }
+    appendGeneratedCell(type, first, points.size());
+}
+
+const std::vector<VTKShard::PointIndex> &VTKShard::connectivity() const {
+    return p_connectivity;
+}
+
+const std::vector<VTKShard::PointIndex> &VTKShard::offsets() const {
+    return p_offsets;
+}
+
+const std::vector<VTKShard::Dimension> &VTKShard::points() const {
+    return p_points;
+}
+
+const std::vector<VTKShard::CellType> &VTKShard::types() const {
+    return p_types;
+}
+
+void VTKShard::appendGeneratedCell(const VTKShard::CellType type, const VTKShard::PointIndex first, const VTKShard::Size count) {
+    for (Size i = 0; i < count; i++)
+        p_connectivity.emplace_back(first + i);
+    p_offsets.emplace_back(p_connectivity.size());
+    p_types.emplace_back(type);
+}
+
+} // namespace exporting
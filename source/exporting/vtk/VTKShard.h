@@ -0,0 +1,243 @@
+//
+//  VTKShard.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 17.10.2026.
+//  Copyright © 2026 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef VTKSHARD_H
+#define VTKSHARD_H
+
+#include "../Span.h"
+#include "VTKCell.h"
+#include "VTKPointTraits.h"
+#include <initializer_list>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * The exporting namespace provides the means to handle exporting simulation data to files.
+ */
+namespace exporting {
+
+/**
+ * @brief The VTKShard class provides the means to collect the points, cells, and attributes of one thread in memory,
+ *        to be merged into a vtk file later on (see VTKFile::enableShards).
+ * @details The shard does not touch any file, so the shards of different threads can be appended to concurrently
+ *          without any lock. The point indexes are local to the shard and are remapped once the shard is merged.
+ * @note A shard should only be appended to by one thread at a time.
+ */
+class VTKShard
+{
+public:
+
+    using CellType = VTKCell::Type;
+    using Dimension = double;
+    using PointIndex = unsigned long;
+    using Size = std::size_t;
+    template<typename T>
+    using Attributes = std::map<std::string, std::vector<T> >;    // The values of the attributes of one data type.
+
+    /**
+     * @brief The constructor of an empty shard.
+     */
+    VTKShard();
+
+    /**
+     * @brief Gives the number of the cells.
+     */
+    Size cellCount() const;
+
+    /**
+     * @brief Gives the number of the points.
+     */
+    Size pointCount() const;
+
+    /**
+     * @brief Whether the shard holds nothing or not.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Removes all the points, cells, and attributes.
+     */
+    void clear();
+
+    /**
+     * @brief Appends a point.
+     * @param x The x of the point.
+     * @param y The y of the point.
+     * @param z The z of the point.
+     * @return The local index of the point.
+     */
+    PointIndex appendPoint(const Dimension x, const Dimension y, const Dimension z);
+
+    /**
+     * @brief Appends a point.
+     * @tparam POINT A fixed-size point having the VTKPointTraits (e.g., Point3).
+     * @param point The point.
+     * @return The local index of the point.
+     */
+    template<typename POINT, typename = std::enable_if_t<VTKPointTraits<POINT>::isPoint> >
+    PointIndex appendPoint(const POINT & point) {
+        using Traits = VTKPointTraits<POINT>;
+        return appendPoint(Traits::x(point), Traits::y(point), Traits::z(point));
+    }
+
+    /**
+     * @brief Appends packed points.
+     * @param xyz The dimension of the points in sereis (i.g., x_0, y_0, z_0, x_1, y_1, ...).
+     * @return The local index of the first added point (i.e., the points have consecutive indexes).
+     * @throws If the dimensions size is not a factor of 3.
+     */
+    PointIndex appendPoints(Span<const Dimension> xyz);
+
+    /**
+     * @brief Appends a cell on the points of the shard.
+     * @note The cell is validated once the shard is merged.
+     * @param type The type of the cell.
+     * @param cellPointsMap The local indexes of the points of the cell.
+     */
+    void appendCell(const CellType type, Span<const PointIndex> cellPointsMap);
+
+    /**
+     * @brief Appends a cell along its points.
+     * @param type The type of the cell.
+     * @param points The location of cell's vertices.
+     * @throws If any of the points does not have 3 dimensions.
+     */
+    void appendCell(const CellType type, const std::vector<std::vector<Dimension> > & points);
+
+    /**
+     * @brief Appends a cell along its points.
+     * @tparam POINTS An iterable of fixed-size points having the VTKPointTraits (e.g., std::vector<Point3>).
+     * @param type The type of the cell.
+     * @param points The location of cell's vertices.
+     */
+    template<typename POINTS, typename = std::enable_if_t<isVTKPointRange<POINTS>::value> >
+    void appendCell(const CellType type, const POINTS & points) {
+        const auto first = pointCount();
+        for (const auto & point : points)
+            appendPoint(point);
+        appendGeneratedCell(type, first, std::size(points));
+    }
+
+    /**
+     * @brief Appends a cell along its points.
+     * @note Allows the brace-enclosed points, e.g., appendCell(Cell::Line, {point0, point1}).
+     * @tparam POINT A fixed-size point having the VTKPointTraits (e.g., Point3).
+     * @param type The type of the cell.
+     * @param points The location of cell's vertices.
+     */
+    template<typename POINT, typename = std::enable_if_t<VTKPointTraits<POINT>::isPoint> >
+    void appendCell(const CellType type, std::initializer_list<POINT> points) {
+        appendCell<std::initializer_list<POINT> >(type, points);
+    }
+
+    /**
+     * @brief Appends values to an attribute.
+     * @note The attribute section (e.g., its type and source) is set on the vtk file, the values keep their data type.
+     * @tparam T The type of the values (i.e., int, float, or double as the attribute sections).
+     * @param name The name of the attribute.
+     * @param values The values of the attribute.
+     * @throws If the data type is changed form the privious added data type of the attribute.
+     */
+    template<typename T>
+    void appendAttribute(const std::string & name, Span<const T> values) {
+        static_assert(std::is_same_v<T, int> || std::is_same_v<T, float> || std::is_same_v<T, double>,
+                      "The attribute values should be int, float, or double.");
+        if ((!std::is_same_v<T, int> && p_intAttributes.count(name))
+                || (!std::is_same_v<T, float> && p_floatAttributes.count(name))
+                || (!std::is_same_v<T, double> && p_doubleAttributes.count(name)))
+            throw std::runtime_error("The attribute of the shard has values of another data type.");
+        auto & attribute = attributesOf<T>()[name];
+        attribute.insert(attribute.end(), values.begin(), values.end());
+    }
+
+    /**
+     * @brief Appends values to an attribute.
+     * @tparam T The type of the values (i.e., int, float, or double as the attribute sections).
+     * @param name The name of the attribute.
+     * @param values The values of the attribute.
+     * @throws If the data type is changed form the privious added data type of the attribute.
+     */
+    template<typename T>
+    void appendAttribute(const std::string & name, const std::vector<T> & values) {
+        appendAttribute(name, Span<const T>(values));
+    }
+
+    /**
+     * @brief Gives the values of the attributes of a data type.
+     * @tparam T The type of the values (i.e., int, float, or double).
+     */
+    template<typename T>
+    const Attributes<T> & attributes() const {
+        if constexpr (std::is_same_v<T, int>)
+            return p_intAttributes;
+        else if constexpr (std::is_same_v<T, float>)
+            return p_floatAttributes;
+        else
+            return p_doubleAttributes;
+    }
+
+    /**
+     * @brief Gives the point indexes of the cells, cell after cell.
+     */
+    const std::vector<PointIndex> & connectivity() const;
+
+    /**
+     * @brief Gives the offsets of the cells inside the connectivity, one more than the cells.
+     */
+    const std::vector<PointIndex> & offsets() const;
+
+    /**
+     * @brief Gives the dimension of the points in sereis (i.g., x_0, y_0, z_0, x_1, y_1, ...).
+     */
+    const std::vector<Dimension> & points() const;
+
+    /**
+     * @brief Gives the types of the cells.
+     */
+    const std::vector<CellType> & types() const;
+
+private:
+
+    /**
+     * @brief Appends a cell on consecutive points.
+     * @param type The type of the cell.
+     * @param first The local index of the first point of the cell.
+     * @param count The number of the points of the cell.
+     */
+    void appendGeneratedCell(const CellType type, const PointIndex first, const Size count);
+
+    /**
+     * @brief Gives the attributes of a data type.
+     * @tparam T The type of the values (i.e., int, float, or double).
+     */
+    template<typename T>
+    Attributes<T> & attributesOf() {
+        if constexpr (std::is_same_v<T, int>)
+            return p_intAttributes;
+        else if constexpr (std::is_same_v<T, float>)
+            return p_floatAttributes;
+        else
+            return p_doubleAttributes;
+    }
+
+    Attributes<double> p_doubleAttributes;  // The values of the double attributes.
+    Attributes<float> p_floatAttributes;    // The values of the float attributes.
+    Attributes<int> p_intAttributes;        // The values of the int attributes.
+    std::vector<PointIndex> p_connectivity; // The local point indexes of the cells.
+    std::vector<PointIndex> p_offsets;      // The offsets of the cells inside the connectivity.
+    std::vector<Dimension> p_points;        // The packed points.
+    std::vector<CellType> p_types;          // The types of the cells.
+
+};
+
+} // namespace exporting
+
+#endif // VTKSHARD_H